@@ -5,25 +5,69 @@
  * Email: knimmo1@dmacc.edu
  *
  * Notes:
- * - Uses even-money settlements (no blackjack 3:2, no splits/doubles/insurance).
+ * - Uses even-money settlements (no blackjack 3:2, no insurance); splits and doubles per hand.
  * - Table.startRound() deals 2 to each player and 2 to dealer.
  * - Players decide hit/stand; then dealer plays (hit 16, stand 17).
- * - Deck auto-reshuffles when empty, per your Deck::deal() implementation.
+ * - Any seat can be a bot that plays a BotStrategy instead of prompting.
+ * - Every interactive round is appended to the binary hand history
+ *   (hand_history.bin); scripted sessions keep none.
+ * - "convert" / "query" / "bench-*" arguments run a tool instead of a game.
+ * - The interactive table is mirrored to a shared-memory spectator feed
+ *   ("club_paradise_table", or "club_paradise_table_2", ... when other
+ *   games already run); "spectate [name]" in another process watches it.
+ * - Each round's output is composed in a FrameBuffer and written once per
+ *   prompt / end of round instead of flushing every line (render.h).
+ * - Deck auto-reshuffles when empty, per your Deck::deal() implementation;
+ *   the next shoe is pre-shuffled on a background thread (ShoePipeline).
  * - ChatGPT was used for comments and some debugging assistance only
  */
 
+#include <chrono>
+#include <fstream>
 #include <iostream>
 #include <limits>
 #include <vector>
 #include <memory>
+#include <map>
 #include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
 #include "deck.h"
+#include "shoe_pipeline.h"
 #include "table.h"
 #include "player.h"
 #include "dealer.h"
+#include "strategy.h"
+#include "journal.h"
+#include "handstore.h"
+#include "bench.h"
+#include "sidebet.h"
+#include "simulation.h"
+#include "ruin.h"
+#include "betramp.h"
+#include "deviation.h"
+#include "render.h"
+#include "loadgen.h"
+#include "spectator.h"
+#include "sessions.h"
+#include "wallet.h"
+#include "rules.h"
 
 using namespace std;
 
+// House rules file for interactive and scripted sessions (format in rules.h).
+static const char* const kRulesFile = "club_rules.cfg";
+// Audit journal and spectator segment of the interactive game; scripted
+// sessions use neither.
+static const char* const kJournalFile = "hand_history.bin";
+static const char* const kFeedName = "club_paradise_table";
+
+// Scripted sessions (see runScript): answers come from a file instead of
+// the keyboard, and running out of answers ends the session cleanly.
+static bool scriptedInput = false;
+static bool inputEnded = false;
+
 // ====================================================
 // Introduction & User Instructions
 // ====================================================
@@ -48,6 +92,9 @@ static void showHowToPlay() {
     cout << "4. Each player takes turns choosing to 'Hit' (draw a card)\n";
     cout << "   or 'Stand' (keep current hand).\n";
     cout << "   If your hand exceeds 21, you 'bust' and lose your bet.\n";
+    cout << "   - 'Double' (D) on two cards: double the bet, take one card.\n";
+    cout << "   - 'Split' (S) a pair into two hands, each with its own bet\n";
+    cout << "     (up to 4 hands; split aces get one card each).\n";
     cout << "5. After all players finish, the dealer plays next:\n";
     cout << "   - Dealer hits on 16 and stands on 17 or higher.\n";
     cout << "6. Closest to 21 without going over wins even money!\n";
@@ -55,6 +102,7 @@ static void showHowToPlay() {
     cout << "-----------------------------------------\n";
     cout << "At any time, press 'H' when prompted to re-display these rules.\n";
     cout << "-----------------------------------------\n\n";
+    if (scriptedInput) return;        // no pause in scripted sessions
     cout << "Press Enter to start the game...";
     cin.ignore(numeric_limits<streamsize>::max(), '\n');
     cout << "\n\n";
@@ -74,10 +122,22 @@ static void clearCin() {
     cin.ignore(numeric_limits<streamsize>::max(), '\n');
 }
 
+/**
+ * readLine(s)
+ * getline(cin) that notes the end of input (end of a script, or a closed
+ * stdin). Returns false once there is nothing left to read; every prompt
+ * then falls back to its safe answer instead of asking forever.
+ */
+static bool readLine(string& s) {
+    if (getline(cin, s)) return true;
+    inputEnded = true;
+    return false;
+}
+
 /**
  * promptInt(prompt, minVal, maxVal)
  * Repeatedly prompts until the user enters an integer in range.
- * Returns the validated integer.
+ * Returns the validated integer (minVal once input has ended).
  */
 static int promptInt(const string& prompt, int minVal, int maxVal) {
     int v;
@@ -87,6 +147,10 @@ static int promptInt(const string& prompt, int minVal, int maxVal) {
             clearCin();
             return v;
         }
+        if (cin.eof()) {
+            inputEnded = true;
+            return minVal;
+        }
         cout << "Please enter an integer between " << minVal << " and " << maxVal << ".\n";
         clearCin();
     }
@@ -95,13 +159,13 @@ static int promptInt(const string& prompt, int minVal, int maxVal) {
 /**
  * promptString(prompt, minLen)
  * Repeatedly prompts until a non-empty (length >= minLen) line is entered.
- * Returns the entered string.
+ * Returns the entered string ("Player" once input has ended).
  */
 static string promptString(const string& prompt, size_t minLen = 1) {
     string s;
     while (true) {
         cout << prompt;
-        getline(cin, s);
+        if (!readLine(s)) return "Player";
         if (s.size() >= minLen) return s;
         cout << "Please enter at least " << minLen << " character(s).\n";
     }
@@ -110,13 +174,14 @@ static string promptString(const string& prompt, size_t minLen = 1) {
 /**
  * promptYesNo(prompt)
  * Asks a yes/no question. Accepts 'y', 'n', or 'h' to view the rules.
- * Returns true for 'y', false for 'n'. Loops on invalid input.
+ * Returns true for 'y', false for 'n' (or once input has ended).
+ * Loops on invalid input.
  */
 static bool promptYesNo(const string& prompt) {
     while (true) {
         cout << prompt << " (y/n or h for help): ";
         string s;
-        getline(cin, s);
+        if (!readLine(s)) return false;
         if (s.empty()) continue;
         char c = tolower(static_cast<unsigned char>(s[0]));
         if (c == 'y') return true;
@@ -130,16 +195,16 @@ static bool promptYesNo(const string& prompt) {
 }
 
 /**
- * promptBetFor(player, maxBank)
- * Prompts for a wager from 1..maxBank. If user types 'h', shows
- * rules and re-prompts. Returns the validated bet.
+ * promptBetFor(player, minBet, maxBank)
+ * Prompts for a wager from minBet..maxBank. If user types 'h', shows
+ * rules and re-prompts. Returns the validated bet (minBet once input has ended).
  */
-static int promptBetFor(Player& p, int maxBank) {
+static int promptBetFor(Player& p, int minBet, int maxBank) {
     while (true) {
         cout << "Enter bet for " << p.getName()
-            << " ($1-" << maxBank << ", or h for help): ";
+            << " ($" << minBet << "-" << maxBank << ", or h for help): ";
         string input;
-        getline(cin, input);
+        if (!readLine(input)) return minBet;
         if (input.empty()) continue;
         if (tolower(input[0]) == 'h') {
             showHowToPlay();
@@ -147,13 +212,13 @@ static int promptBetFor(Player& p, int maxBank) {
         }
         try {
             int bet = stoi(input);
-            if (bet >= 1 && bet <= maxBank)
+            if (bet >= minBet && bet <= maxBank)
                 return bet;
         }
         catch (...) {
             // fall through to error message
         }
-        cout << "Invalid bet. Enter a number between 1 and " << maxBank << ".\n";
+        cout << "Invalid bet. Enter a number between " << minBet << " and " << maxBank << ".\n";
     }
 }
 
@@ -172,52 +237,155 @@ static void printHandInline(const Person& who) {
 // ====================================================
 
 /**
- * playPlayerTurn(player, deck)
- * Runs one player's turn: repeatedly show their hand, then ask
- * "Hit?" If they hit, deal a card. If they stand, stop. If they
- * bust (hand > 21), announce and end turn.
+ * printHandHeader(player, hand)
+ * Prints "<name>'s hand: [..] value=N", numbering the hand once the
+ * player has split.
+ */
+static void printHandHeader(const Player& p, int h) {
+    cout << p.getName() << "'s hand";
+    if (p.handCount() > 1) cout << " " << (h + 1);
+    cout << ": ";
+    p.showHand(h);
+    cout << " value=" << p.handAt(h).value() << "\n";
+}
+
+/**
+ * playPlayerHand(player, hand, table)
+ * Runs one of the player's hands: repeatedly show it, then ask
+ * "Hit?" If they hit, the Table deals a card. If they stand, stop. If they
+ * bust (hand > 21), announce and end the hand. Double and split are
+ * offered when the hand allows them.
  *
  * Larger method sections:
  *  - Show current hand/value
- *  - Bust check exits early
- *  - Prompt for action (y/n/h), apply decision
+ *  - Bust / locked-hand check exits early
+ *  - Prompt for action (y/n/d/s/h), apply decision
  */
-static void playPlayerTurn(Player& p, Deck& deck) {
+static void playPlayerHand(Player& p, int h, Table& table) {
     while (true) {
-        // Show the current state of this player's hand
-        cout << p.getName() << "'s hand: ";
-        p.showHand();
-        cout << " value=" << p.handValue() << "\n";
+        // Show the current state of this hand
+        printHandHeader(p, h);
 
-        // If already busted, end the turn immediately
-        if (p.handValue() > 21) {
+        // If already busted, end the hand immediately
+        if (p.handAt(h).value() > 21) {
             cout << p.getName() << " busts!\n";
             return;
         }
-
-        // Prompt for the next action: Hit, Stand, or Help
-        cout << "Hit (H to view rules)? (y/n): ";
+        // Doubled hands and split aces take no more cards
+        if (p.isHandLocked(h)) return;
+
+        // Prompt for the next action: Hit, Stand, Double, Split, or Help
+        const bool canDouble = p.canDouble(h);
+        const bool canSplit = p.canSplit(h);
+        cout << "Hit (H to view rules)? (y/n" << (canDouble ? "/d=double" : "")
+             << (canSplit ? "/s=split" : "") << "): ";
         string s;
-        getline(cin, s);
+        if (!readLine(s)) s = "n";           // out of input: stand
         if (s.empty()) continue;
         char c = tolower(static_cast<unsigned char>(s[0]));
         if (c == 'y') {
             // Deal one card and continue loop
-            p.cardDealt(deck.deal());
+            table.playerHit(p, h);
             continue;
         }
         else if (c == 'n') {
-            // End the player's turn
+            // End this hand
+            table.playerStand(p);
             cout << p.getName() << " stands.\n";
             return;
         }
+        else if (c == 'd' && canDouble) {
+            // One card at double the bet; the loop shows it and ends the hand
+            table.playerDouble(p, h);
+            cout << p.getName() << " doubles to $" << p.betOn(h) << ".\n";
+            continue;
+        }
+        else if (c == 's' && canSplit) {
+            // The new hand is played after this one
+            table.playerSplit(p, h);
+            cout << p.getName() << " splits.\n";
+            continue;
+        }
         else if (c == 'h') {
             // Show rules and re-ask
             showHowToPlay();
             continue;
         }
         else {
-            cout << "Please enter y, n, or h.\n";
+            cout << "Please enter y, n" << (canDouble ? ", d" : "") << (canSplit ? ", s" : "") << " or h.\n";
+        }
+    }
+}
+
+/**
+ * playPlayerTurn(player, table)
+ * Runs one player's turn: every hand in order (a split adds hands
+ * to the end of the list while the loop runs).
+ */
+static void playPlayerTurn(Player& p, Table& table) {
+    for (int h = 0; h < p.handCount(); ++h) playPlayerHand(p, h, table);
+}
+
+/**
+ * promptStrategy(name)
+ * Asks which automated strategy a bot seat should play.
+ */
+static BotStrategy promptStrategy(const string& name) {
+    cout << "Strategies: 1) basic  2) hit below 17  3) mimic the dealer  4) hi-lo counting\n";
+    int choice = promptInt("Strategy for " + name + " (1-4): ", 1, 4);
+    switch (choice) {
+    case 1: return BasicStrategy{};
+    case 2: return HitBelow{ 17 };
+    case 3: return MimicDealer{};
+    default: return HiLoCounting{};
+    }
+}
+
+/**
+ * botBetFor(player)
+ * Bots flat-bet 2% of their starting bank (at least $1),
+ * capped by what they have left.
+ */
+static int botBetFor(const Player& p) {
+    int bet = p.getStartingMoney() / 50;
+    if (bet < 1) bet = 1;
+    if (bet > p.getMoney()) bet = p.getMoney();
+    return bet;
+}
+
+/**
+ * playBotSeat(player, strategy, table)
+ * Same flow as playPlayerTurn, but each split/double/hit/stand decision
+ * comes from the bot's strategy instead of a prompt.
+ */
+static void playBotSeat(Player& p, BotStrategy& strategy, Table& table) {
+    for (int h = 0; h < p.handCount(); ++h) {
+        while (true) {
+            printHandHeader(p, h);
+
+            if (p.handAt(h).value() > 21) {
+                cout << p.getName() << " busts!\n";
+                break;
+            }
+            if (p.isHandLocked(h)) break;
+            const HandContext c = makeContext(p, h, table);
+            if (decideSplit(strategy, c)) {
+                cout << p.getName() << " (" << strategyName(strategy) << ") splits.\n";
+                table.playerSplit(p, h);
+                continue;
+            }
+            if (decideDouble(strategy, c)) {
+                cout << p.getName() << " (" << strategyName(strategy) << ") doubles.\n";
+                table.playerDouble(p, h);
+                continue;
+            }
+            if (c.total == 21 || !decideHit(strategy, c)) {
+                table.playerStand(p);
+                cout << p.getName() << " (" << strategyName(strategy) << ") stands.\n";
+                break;
+            }
+            cout << p.getName() << " (" << strategyName(strategy) << ") hits.\n";
+            table.playerHit(p, h);
         }
     }
 }
@@ -275,8 +443,8 @@ static string signedMoney(int n) {
 /**
  * printFinalReport(roster, roundsPlayed)
  * Prints a final table when the user quits showing, for each
- * player, starting funds, ending funds, net delta, and
- * win/loss/push counts collected by Player.
+ * player, starting funds, ending funds, net delta, largest drawdown
+ * and win/loss/push counts collected by Player.
  */
 static void printFinalReport(const vector<shared_ptr<Player>>& roster, int roundsPlayed) {
     cout << "\n=========================================\n";
@@ -288,12 +456,13 @@ static void printFinalReport(const vector<shared_ptr<Player>>& roster, int round
         << right << setw(12) << "Start($)"
         << right << setw(12) << "End($)"
         << right << setw(12) << "Net($)"
+        << right << setw(12) << "MaxDD($)"
         << right << setw(12) << "Wins"
         << right << setw(8) << "Loss"
         << right << setw(8) << "Push"
         << "\n";
 
-    cout << string(16 + 12 + 12 + 12 + 12 + 8 + 8, '-') << "\n";
+    cout << string(16 + 12 + 12 + 12 + 12 + 12 + 8 + 8, '-') << "\n";
 
     for (const auto& up : roster) {
         const int start = up->getStartingMoney();
@@ -304,53 +473,150 @@ static void printFinalReport(const vector<shared_ptr<Player>>& roster, int round
             << right << setw(12) << start
             << right << setw(12) << end
             << right << setw(12) << signedMoney(net)
+            << right << setw(12) << up->getMaxDrawdown()
             << right << setw(12) << up->getWins()
             << right << setw(8) << up->getLosses()
             << right << setw(8) << up->getPushes()
             << "\n";
     }
 
-    cout << string(16 + 12 + 12 + 12 + 12 + 8 + 8, '-') << "\n\n";
+    cout << string(16 + 12 + 12 + 12 + 12 + 12 + 8 + 8, '-') << "\n\n";
+}
+
+/**
+ * formatMicros(ns)
+ * Formats a nanosecond latency as microseconds with one decimal.
+ */
+static string formatMicros(uint64_t ns) {
+    ostringstream os;
+    os << fixed << setprecision(1) << (ns / 1000.0);
+    return os.str();
+}
+
+/**
+ * printLatencyReport(latency)
+ * Prints tail latency (p50/p99/p99.9/max, in microseconds) of the
+ * server-side work in each round phase. Time spent waiting on a
+ * prompt is never included.
+ */
+static void printLatencyReport(const RoundLatency& latency) {
+    struct Row { const char* name; const LatencyHistogram* h; };
+    const Row rows[] = {
+        { "Start round",   &latency.startRound },
+        { "Player action", &latency.playerAction },
+        { "Dealer play",   &latency.dealerPlay },
+        { "Settle bets",   &latency.settleBets },
+    };
+
+    cout << "Round latency (us):\n";
+    cout << left << setw(16) << "Phase"
+        << right << setw(8) << "Count"
+        << right << setw(10) << "p50"
+        << right << setw(10) << "p99"
+        << right << setw(10) << "p99.9"
+        << right << setw(10) << "max"
+        << "\n";
+    cout << string(16 + 8 + 10 + 10 + 10 + 10, '-') << "\n";
+
+    for (const Row& r : rows) {
+        cout << left << setw(16) << r.name
+            << right << setw(8) << r.h->count()
+            << right << setw(10) << formatMicros(r.h->percentile(50.0))
+            << right << setw(10) << formatMicros(r.h->percentile(99.0))
+            << right << setw(10) << formatMicros(r.h->percentile(99.9))
+            << right << setw(10) << formatMicros(r.h->max())
+            << "\n";
+    }
+
+    cout << string(16 + 8 + 10 + 10 + 10 + 10, '-') << "\n\n";
 }
 
 // ====================================================
-// Main Program
+// Session
 // ====================================================
 
 /**
- * main()
- * High-level loop of the game:
- *  1) Show rules
- *  2) Create deck/table and collect players
- *  3) For each round:
- *     - Collect bets
- *     - Deal two cards to everyone
- *     - Let each player play their turn
- *     - Dealer plays, then Table settles bets
- *     - Print a round summary
- *     - Ask to continue; on 'no', print final report and exit
+ * SessionSummary
+ * Final state of a session, for the scripted mode's report.
+ */
+struct SessionSummary {
+    int rounds = 0;
+    vector<Player> players;
+    RoundLatency latency;
+};
+
+/**
+ * runSession(seed, maxRounds, quiet, summary, journalPath, feedName)
+ * The game itself (rules screen, player setup, round loop, final report).
+ *  - seed: 0 = random shoes, else the same shoes every run
+ *  - maxRounds: 0 = ask "Play another round?", else stop after that many
+ *  - quiet: round output is composed but never written
+ *  - summary: filled at the end of the game when not null
+ *  - journalPath / feedName: hand history file and spectator segment
+ *    ("" = no journal / no feed)
  */
-int main() {
+static int runSession(unsigned int seed, int maxRounds, bool quiet, SessionSummary* summary,
+    const string& journalPath, const string& feedName) {
     cout << "=== Blackjack (Console) ===\n\n";
 
     // One-time instructions screen (press Enter to continue)
     showHowToPlay();
 
-    // Core game objects
-    Deck deck;
+    // Core game objects (a fixed seed replays the same shoes)
+    Deck deck = seed ? Deck(seed) : Deck();
     deck.shuffle();
+    ShoePipeline shoes(deck);        // keeps shuffled shoes ready for deal()
+    deck.attachPipeline(&shoes);
     Table table(deck);
 
+    // Hand history for audit/disputes (group-committed, see journal.h)
+    HandJournal journal;
+    bool journaling = !journalPath.empty() && journal.open(journalPath);
+    if (journaling) table.setJournal(&journal);
+    else if (!journalPath.empty())
+        cout << "(hand history disabled: could not open " << journalPath << ", or it is from another version)\n";
+
+    // Live view for observer processes (spectator.h); the table never waits on them
+    // under feedName, or feedName_2, _3, ... while other live tables hold the names before it
+    SpectatorFeed feed;
+    string feedUsed;
+    for (int t = 1; !feedName.empty() && feedUsed.empty() && t <= 8; ++t) {
+        const string name = t == 1 ? feedName : feedName + "_" + to_string(t);
+        if (feed.create(name)) feedUsed = name;
+    }
+    if (!feedUsed.empty()) {
+        table.setSpectatorFeed(&feed);
+        if (feedUsed != feedName) cout << "(spectator feed: " << feedUsed << ")\n";
+    }
+    else if (!feedName.empty()) cout << "(spectator feed disabled: could not create shared memory)\n";
+
+    // House rules and limits: club_rules.cfg if present (rules.h), re-read
+    // whenever it changes and applied between rounds
+    RuleConfig houseRules;
+    string rulesError;
+    if (!houseRules.reload(kRulesFile, &rulesError) && rulesError.rfind("cannot open", 0) != 0)
+        cout << "(" << kRulesFile << " ignored: " << rulesError << ")\n";
+    RuleWatcher rulesWatcher(houseRules, kRulesFile);
+    RuleConfig::Reader rules(houseRules);
+    table.setRules(&rules);
+    const TableRules& setup = rules.get();
+
     // --- Player setup ---
-    int nPlayers = promptInt("How many players (1-4)? ", 1, 4);
+    int nPlayers = promptInt("How many players (" + to_string(setup.minPlayers) + "-" + to_string(setup.maxPlayers)
+        + ")? ", setup.minPlayers, setup.maxPlayers);
     vector<shared_ptr<Player>> roster;
     vector<shared_ptr<Player>> outPlayers;
+    map<const Player*, BotStrategy> bots;   // seats played by a strategy
     roster.reserve(nPlayers);
 
     for (int i = 0; i < nPlayers; ++i) {
         string name = promptString("Enter player " + to_string(i + 1) + " name: ");
-        int bank = promptInt("Starting bank for " + name + " ($100-$10000): ", 100, 10000);
+        int bank = promptInt("Starting bank for " + name + " ($" + to_string(setup.minBank) + "-$"
+            + to_string(setup.maxBank) + "): ", setup.minBank, setup.maxBank);
         roster.emplace_back(make_unique<Player>(name, bank));
+        if (promptYesNo("Is " + name + " a computer player?")) {
+            bots.emplace(roster.back().get(), promptStrategy(name));
+        }
     }
 
     // Register players with Table
@@ -358,23 +624,34 @@ int main() {
 
     bool keepPlaying = true;
     int roundNum = 1;
+    FrameBuffer frame(quiet ? nullptr : stdout);   // one write per prompt / end of round
 
     // ===========================
     // Round Loop
     // ===========================
     while (keepPlaying) {
+        FrameScope framed(frame);
         cout << "\n--- New Round " << roundNum << " ---\n";
+        if (table.refreshRules()) {
+            const TableRules& now = rules.get();
+            cout << "(house rules updated: dealer " << (now.hitSoft17 ? "hits" : "stands on") << " soft 17, bets $"
+                << now.minBet << "-$" << now.maxBet << ")\n";
+        }
+        const TableRules& limits = rules.get();   // this round's rules
 
         // --- Betting phase ---
         for (auto& up : roster) {
-            int cap = up->getMoney();
+            int cap = min(up->getMoney(), limits.maxBet);
             if (cap <= 0) {
                 // Player is broke; keep them in roster but skip the round
                 cout << up->getName() << " is out of money and will be skipped.\n";
                 up->setBet(0);
                 continue;
             }
-            int bet = promptBetFor(*up, cap);
+            auto bot = bots.find(up.get());
+            const int floor = min(limits.minBet, cap);   // a short stack may bet what it has left
+            int bet = (bot != bots.end()) ? max(floor, min(botBetFor(*up), cap)) : promptBetFor(*up, floor, cap);
+            if (bot != bots.end()) cout << up->getName() << " bets $" << bet << ".\n";
             up->setBet(bet);
         }
 
@@ -387,21 +664,31 @@ int main() {
         // --- Each player's turn ---
         for (auto& up : roster) {
             if (up->getMoney() <= 0) continue;   // skip broke players
-            playPlayerTurn(*up, deck);
+            auto bot = bots.find(up.get());
+            if (bot != bots.end()) playBotSeat(*up, bot->second, table);
+            else playPlayerTurn(*up, table);
         }
 
         // --- Dealer plays, then settle bets vs. dealer ---
         table.dealerPlay();
         table.showDealerHand(true);              // reveal dealer hand
+        for (auto& bot : bots) observeTable(bot.second, table);   // let counters see the round
         table.settleBets();
         table.clearHands();                      // just to be safe; some clears already happen
 
         // --- Round summary and continuation prompt ---
         printRoundSummary(roster, roundNum);
         pruneBrokePlayers(roster, table, outPlayers);
+        if (journaling && journal.failed()) {
+            cout << "(hand history stopped: writing " << journalPath << " failed)\n";
+            table.setJournal(nullptr);
+            journaling = false;
+        }
         // ---If all players are broke this will end the game ---
         if (roster.empty()) {
             keepPlaying = false;
+        }else if (maxRounds > 0) {
+        keepPlaying = roundNum < maxRounds;   // scripted: the driver answers
         }else{
         keepPlaying = promptYesNo("Play another round?");
         }
@@ -412,6 +699,14 @@ int main() {
             }
             // On exit, show a final report with net results and W/L/P
             printFinalReport(roster, /* roundsPlayed = */ roundNum);
+            printLatencyReport(table.latencyStats());
+            if (journaling && !journal.close())
+                cout << "(hand history incomplete: writing " << journalPath << " failed)\n";
+            if (summary) {
+                summary->rounds = roundNum;
+                summary->latency = table.latencyStats();
+                for (auto& up : roster) summary->players.push_back(*up);
+            }
             break;
         }
         ++roundNum;
@@ -420,3 +715,305 @@ int main() {
     cout << "\nThanks for playing!\n";
     return 0;
 }
+
+
+/**
+ * NullBuffer
+ * streambuf that drops everything (quiet scripted sessions).
+ */
+struct NullBuffer : streambuf {
+    int overflow(int c) override { return c; }
+};
+
+/**
+ * jsonString(s)
+ * Quotes a string for the JSON summary (escapes quotes, backslashes
+ * and control characters).
+ */
+static string jsonString(const string& s) {
+    ostringstream os;
+    os << '"';
+    for (unsigned char c : s) {
+        if (c == '"' || c == '\\') os << '\\' << c;
+        else if (c < 0x20) os << "\\u" << hex << setw(4) << setfill('0') << static_cast<int>(c) << dec << setfill(' ');
+        else os << c;
+    }
+    os << '"';
+    return os.str();
+}
+
+/**
+ * runScript(path, rounds, seed, verbose)
+ * Plays a whole session through runSession with std::cin reading from a
+ * script: the same answers a person would type, one per line (player
+ * count, names, banks, "is a computer player?" + strategy, bets, y/n/d/s,
+ * "play another round?"). Bot seats make their own decisions, so a
+ * script of only bots is a few lines long.
+ *  - rounds > 0: the driver answers "play another round?" itself
+ *  - the end of the script answers every remaining prompt safely
+ *    (minimum, stand, no), which ends the session
+ *  - game output is dropped unless verbose; a one-line JSON summary
+ *    goes to stdout either way
+ *  - no hand history and no spectator feed: a test run never touches the
+ *    live game's journal or takes over its feed
+ */
+static int runScript(const string& path, int rounds, unsigned int seed, bool verbose) {
+    ifstream script(path);
+    if (!script) {
+        cout << "cannot open script: " << path << "\n";
+        return 1;
+    }
+    streambuf* savedIn = cin.rdbuf(script.rdbuf());
+    NullBuffer null;
+    streambuf* savedOut = verbose ? nullptr : cout.rdbuf(&null);
+    scriptedInput = true;
+
+    SessionSummary summary;
+    const auto t0 = chrono::steady_clock::now();
+    runSession(seed, rounds, !verbose, &summary, "", "");
+    const double seconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+    cin.rdbuf(savedIn);
+    if (savedOut) cout.rdbuf(savedOut);
+    scriptedInput = false;
+
+    cout << "{\"script\":" << jsonString(path)
+         << ",\"seed\":" << seed
+         << ",\"rounds\":" << summary.rounds
+         << ",\"scriptEnded\":" << (inputEnded ? "true" : "false")
+         << ",\"seconds\":" << seconds
+         << ",\"roundsPerSecond\":" << (seconds > 0 ? summary.rounds / seconds : 0.0)
+         << ",\"players\":[";
+    for (size_t i = 0; i < summary.players.size(); ++i) {
+        const Player& p = summary.players[i];
+        cout << (i ? "," : "") << "{\"name\":" << jsonString(p.getName())
+             << ",\"start\":" << p.getStartingMoney()
+             << ",\"end\":" << p.getMoney()
+             << ",\"net\":" << p.getNet()
+             << ",\"wins\":" << p.getWins()
+             << ",\"losses\":" << p.getLosses()
+             << ",\"pushes\":" << p.getPushes() << "}";
+    }
+    const LatencyHistogram& settle = summary.latency.settleBets;
+    cout << "],\"settleP50Ns\":" << settle.percentile(50.0)
+         << ",\"settleP99Ns\":" << settle.percentile(99.0) << "}\n";
+    return 0;
+}
+
+// ====================================================
+// Main Program
+// ====================================================
+
+/**
+ * main()
+ * High-level loop of the game:
+ *  1) Show rules
+ *  2) Create deck/table and collect players
+ *  3) For each round:
+ *     - Collect bets
+ *     - Deal two cards to everyone
+ *     - Let each player play their turn
+ *     - Dealer plays, then Table settles bets
+ *     - Print a round summary
+ *     - Ask to continue; on 'no', print final report and exit
+ *
+ * Command-line modes (no game is played):
+ *  - convert <journal> <store>: build a columnar hand store
+ *  - query <store> [filters]:   scan a hand store
+ *  - bench-deck [tables] [decks] [passes]: shoe layout benchmark
+ *  - bench-numa [seconds] [seats]: rounds/sec scaling per NUMA node
+ *  - sim-sidebets [rounds] [decks] [threads]: side-bet house edges
+ *  - sim-rules [shoes] [decks] [threads] [antithetic 0|1] [checkpoint]: paired S17 vs H17
+ *  - sim-ruin [bankroll] [horizon] [paths] [is|mc] [threads] [s17|h17] [ramp]: risk of ruin
+ *  - sim-ramp [shoes] [bankroll] [max spread] [threads] [checkpoint]: bet-ramp optimizer
+ *  - sim-index [shoes] [threads] [state file]: stand/hit deviation indices
+ *  - sim-sessions [sessions] [bankroll] [bet] [max rounds] [threads]: session percentiles
+ *  - sim-wallet [tables] [rounds] [bankroll] [bet]: one shared wallet over many tables
+ *  - sim-reload [rules file] [tables] [seconds]: hot-reload rules under running tables
+ *  - watch [tables] [rounds] [diff|full]: bot tables on one screen, diff-redrawn
+ *  - script <file> [rounds] [seed] [quiet|verbose]: non-interactive session, JSON summary
+ *  - load [max sessions] [p99 us] [think scale] [step s] [workers]: session load ramp
+ *  - spectate [segment] [frames]: follow a running game's spectator feed
+ * Any other argument, or a bad one, prints the usage and exits with 1.
+ */
+// Command-line modes and their arguments, printed when a mode is misused
+static const pair<const char*, const char*> kModes[] = {
+    { "convert", "<journal> <store>" },
+    { "query", "<store> [filters]" },
+    { "bench-deck", "[tables] [decks] [passes]" },
+    { "bench-numa", "[seconds] [seats]" },
+    { "sim-sidebets", "[rounds] [decks] [threads]" },
+    { "sim-rules", "[shoes] [decks] [threads] [antithetic 0|1] [checkpoint]" },
+    { "sim-ruin", "[bankroll] [horizon] [paths] [is|mc] [threads] [s17|h17] [ramp]" },
+    { "sim-ramp", "[shoes] [bankroll] [max spread] [threads] [checkpoint]" },
+    { "sim-index", "[shoes] [threads] [state file]" },
+    { "sim-sessions", "[sessions] [bankroll] [bet] [max rounds] [threads]" },
+    { "sim-wallet", "[tables] [rounds] [bankroll] [bet]" },
+    { "sim-reload", "[rules file] [tables] [seconds]" },
+    { "watch", "[tables] [rounds] [diff|full]" },
+    { "script", "<file> [rounds] [seed] [quiet|verbose]" },
+    { "load", "[max sessions] [p99 us] [think scale] [step s] [workers]" },
+    { "spectate", "[segment] [frames]" },
+};
+
+/**
+ * printUsage(mode)
+ * ----------------
+ * The usage line for `mode`, or every mode's if it isn't one of them.
+ */
+static void printUsage(const string& mode) {
+    for (const auto& m : kModes) {
+        if (mode == m.first) {
+            cout << "usage: " << m.first << " " << m.second << "\n";
+            return;
+        }
+    }
+    cout << "unknown mode \"" << mode << "\"; run with no arguments to play, or one of:\n";
+    for (const auto& m : kModes) cout << "  " << m.first << " " << m.second << "\n";
+}
+
+/**
+ * numArg(argc, argv, i, fallback)
+ * -------------------------------
+ * argv[i] as a number, `fallback` if there are fewer arguments. Throws
+ * std::invalid_argument (what() = the argument) on anything that isn't a
+ * number that fits T (stoi alone accepts "12abc"). T is int, unsigned, long long
+ * or double.
+ */
+template <class T>
+static T numArg(int argc, char* argv[], int i, T fallback) {
+    if (argc <= i) return fallback;
+    const string text = argv[i];
+    size_t used = 0;
+    T value;
+    try {
+        if constexpr (is_floating_point<T>::value) {
+            value = static_cast<T>(stod(text, &used));
+        }
+        else {
+            const long long whole = stoll(text, &used);
+            if (whole < static_cast<long long>(numeric_limits<T>::min())
+                || whole > static_cast<long long>(numeric_limits<T>::max()))
+                throw out_of_range(text);
+            value = static_cast<T>(whole);
+        }
+    }
+    catch (const logic_error&) {
+        throw invalid_argument(text);   // stod/stoll only say "stod"/"stoll"
+    }
+    if (used != text.size()) throw invalid_argument(text);
+    return value;
+}
+
+/**
+ * flagArg(argc, argv, i, on, off)
+ * -------------------------------
+ * true for `on`, false for `off` or a missing argument; throws
+ * std::invalid_argument on any other word.
+ */
+static bool flagArg(int argc, char* argv[], int i, const char* on, const char* off) {
+    if (argc <= i || string(argv[i]) == off) return false;
+    if (string(argv[i]) == on) return true;
+    throw invalid_argument(argv[i]);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc == 1) return runSession(0, 0, false, nullptr, kJournalFile, kFeedName);
+
+    const string mode = argv[1];
+    try {
+        if (mode == "convert" || mode == "query") return runHandStoreTool(argc, argv);
+        if (mode == "bench-deck") {
+            return runDeckBench(numArg(argc, argv, 2, 10000),
+                numArg(argc, argv, 3, 8),
+                numArg(argc, argv, 4, 2000LL));
+        }
+        if (mode == "bench-numa") {
+            return runNumaBench(numArg(argc, argv, 2, 2.0),
+                numArg(argc, argv, 3, 1));
+        }
+        if (mode == "sim-sidebets") {
+            return runSideBetSim(numArg(argc, argv, 2, 10000000LL),
+                numArg(argc, argv, 3, 6),
+                numArg(argc, argv, 4, 0));
+        }
+        if (mode == "sim-rules") {
+            return runRuleComparison(numArg(argc, argv, 2, 100000LL),
+                numArg(argc, argv, 3, 6),
+                numArg(argc, argv, 4, 0),
+                flagArg(argc, argv, 5, "1", "0"),
+                argc > 6 ? argv[6] : "");
+        }
+        if (mode == "sim-ruin") {
+            return runRuinTool(numArg(argc, argv, 2, 200),
+                numArg(argc, argv, 3, 1000LL),
+                numArg(argc, argv, 4, 100000LL),
+                !flagArg(argc, argv, 5, "mc", "is"),
+                numArg(argc, argv, 6, 0),
+                flagArg(argc, argv, 7, "h17", "s17"),
+                argc > 8 ? argv[8] : "");
+        }
+        if (mode == "sim-ramp") {
+            return runRampOptimizer(numArg(argc, argv, 2, 50000LL),
+                numArg(argc, argv, 3, 1000),
+                numArg(argc, argv, 4, 12),
+                numArg(argc, argv, 5, 0),
+                argc > 6 ? argv[6] : "");
+        }
+        if (mode == "sim-index") {
+            return runDeviationTool(numArg(argc, argv, 2, 20000LL),
+                numArg(argc, argv, 3, 0),
+                argc > 4 ? argv[4] : "deviation_index.state");
+        }
+        if (mode == "sim-sessions") {
+            return runSessionTool(numArg(argc, argv, 2, 10000LL),
+                numArg(argc, argv, 3, 1000),
+                numArg(argc, argv, 4, 10),
+                numArg(argc, argv, 5, 1000),
+                numArg(argc, argv, 6, 0));
+        }
+        if (mode == "sim-wallet") {
+            return runWalletSim(numArg(argc, argv, 2, 4),
+                numArg(argc, argv, 3, 100000LL),
+                numArg(argc, argv, 4, 1000),
+                numArg(argc, argv, 5, 10));
+        }
+        if (mode == "sim-reload") {
+            return runReloadTool(argc > 2 ? argv[2] : kRulesFile,
+                numArg(argc, argv, 3, 4),
+                numArg(argc, argv, 4, 10.0));
+        }
+        if (mode == "script") {
+            if (argc < 3) {
+                printUsage(mode);
+                return 1;
+            }
+            return runScript(argv[2], numArg(argc, argv, 3, 0),
+                numArg(argc, argv, 4, 1u),
+                flagArg(argc, argv, 5, "verbose", "quiet"));
+        }
+        if (mode == "load") {
+            return runLoadTool(numArg(argc, argv, 2, 8192),
+                numArg(argc, argv, 3, 20000.0),
+                numArg(argc, argv, 4, 1.0),
+                numArg(argc, argv, 5, 3.0),
+                numArg(argc, argv, 6, 0));
+        }
+        if (mode == "spectate") {
+            return runSpectator(argc > 2 ? argv[2] : kFeedName,
+                numArg(argc, argv, 3, 0LL));
+        }
+        if (mode == "watch") {
+            return runTableWatch(numArg(argc, argv, 2, 4),
+                numArg(argc, argv, 3, 200),
+                !flagArg(argc, argv, 4, "full", "diff"));
+        }
+    }
+    catch (const invalid_argument& bad) {
+        cout << "bad argument \"" << bad.what() << "\"\n";
+        printUsage(mode);
+        return 1;
+    }
+    printUsage(mode);
+    return 1;
+}
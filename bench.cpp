@@ -0,0 +1,222 @@
+/*
+ * Benchmarks Implementation
+ * -------------------------
+ * runDeckBench compares the shoe layouts under many-table cache pressure:
+ *  - IntShoe: the previous Deck layout (vector<int>, 4 bytes per card)
+ *  - Deck:    the packed layout (vector<uint8_t>, 1 byte per card)
+ * Both rebuild with the same seeded shuffle into a buffer they keep, so
+ * the dealt cards (and the checksum printed for each) match and neither
+ * allocates on a reshuffle; IntShoe then widens the codes to values.
+ *
+ * runNumaBench times free-running tables. A worker checks the clock once
+ * per batch of rounds and writes its round count once, at the end, so the
+ * only shared write during a step is that final store.
+ */
+
+#include "bench.h"
+#include "card.h"
+#include "deck.h"
+#include "numa.h"
+#include "stats.h"
+#include "strategy.h"
+#include "table.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+// The pre-packing Deck, kept only as a baseline.
+class IntShoe {
+public:
+    IntShoe(unsigned int inSeed, int inDecks) : seed(inSeed), decks(inDecks) {}
+
+    int deal() {
+        if (shoe.empty()) {
+            ++shuffles;
+            Deck::buildShoe(bytes, seed, decks, shuffles);
+            shoe.resize(bytes.size());
+            for (size_t i = 0; i < bytes.size(); ++i) shoe[i] = card::value(bytes[i]);
+        }
+        int card = shoe.back();
+        shoe.pop_back();
+        return card;
+    }
+    // a full shoe's cards (what the layout costs, not what vector reserved)
+    size_t shoeBytes() const { return static_cast<size_t>(decks) * 52 * sizeof(int); }
+
+private:
+    vector<int> shoe;
+    vector<uint8_t> bytes;      // reshuffle buffer, reused like Deck's own shoe
+    unsigned int seed;
+    int decks;
+    int shuffles = 0;
+};
+
+template <class Shoe>
+static double timeDeals(vector<Shoe>& shoes, long long passes, unsigned long long& checksum) {
+    const uint64_t start = stats::nowNanos();
+    for (long long p = 0; p < passes; ++p) {
+        for (Shoe& s : shoes) checksum += static_cast<unsigned long long>(s.deal());
+    }
+    return (stats::nowNanos() - start) / 1e9;
+}
+
+// One worker's table and everything it writes while playing.
+struct BenchTable {
+    Deck deck;
+    Table table;
+    vector<unique_ptr<Player>> players;
+    vector<RoundResult> results;
+
+    BenchTable(unsigned int seed, int seats) : deck(seed, 6), table(deck), results(64) {
+        for (int i = 0; i < seats; ++i) {
+            players.push_back(make_unique<Player>("bench", 1 << 30));
+            players.back()->setBet(1);
+            table.addPlayer(players.back().get());
+        }
+    }
+
+    long long playFor(double seconds) {
+        BasicStrategy policy;
+        const uint64_t end = stats::nowNanos() + static_cast<uint64_t>(seconds * 1e9);
+        long long rounds = 0;
+        while (stats::nowNanos() < end)
+            rounds += static_cast<long long>(table.playRounds(results.size(), policy, results.data()));
+        return rounds;
+    }
+};
+
+// Total rounds played by `workers` workers in `seconds`.
+long long runStep(size_t workers, size_t nodes, bool pinned, double seconds, int seats) {
+    vector<long long> rounds(workers, 0);
+    if (pinned) {
+        numa::runPinned(workers, [&](size_t t) {
+            BenchTable mine(1000u + static_cast<unsigned int>(t), seats);
+            rounds[t] = mine.playFor(seconds);
+        }, nodes);
+    }
+    else {
+        vector<unique_ptr<BenchTable>> tables;
+        for (size_t t = 0; t < workers; ++t)
+            tables.push_back(make_unique<BenchTable>(1000u + static_cast<unsigned int>(t), seats));
+        vector<thread> pool;
+        for (size_t t = 0; t < workers; ++t)
+            pool.emplace_back([&, t]() { rounds[t] = tables[t]->playFor(seconds); });
+        for (thread& w : pool) w.join();
+    }
+    long long total = 0;
+    for (long long r : rounds) total += r;
+    return total;
+}
+
+} // namespace
+
+/**
+ * runDeckBench(tables, decks, passes)
+ * -----------------------------------
+ * Warms every shoe (first build) outside the timed loop, then deals
+ * `passes` cards from each table in round-robin order. The layouts run
+ * int, packed, packed, int so neither always goes first (warm caches,
+ * turbo clocks); each rate is over both of its runs.
+ */
+int runDeckBench(int tables, int decks, long long passes) {
+    if (tables < 1 || decks < 1 || passes < 1) {
+        cout << "usage: bench-deck [tables] [decks] [passes]\n";
+        return 1;
+    }
+
+    vector<IntShoe> wide;
+    vector<Deck> packed;
+    wide.reserve(tables);
+    packed.reserve(tables);
+    for (int t = 0; t < tables; ++t) {
+        wide.emplace_back(1000u + t, decks);
+        packed.emplace_back(1000u + t, decks);
+    }
+    unsigned long long warm = 0;
+    for (auto& s : wide) warm += s.deal();
+    for (auto& d : packed) warm += d.deal();
+
+    // both layouts counted the same way: a full shoe of cards per table
+    size_t wideBytes = 0, packedBytes = 0;
+    for (const auto& s : wide) wideBytes += s.shoeBytes();
+    for (const auto& d : packed) packedBytes += d.shoeSize() * sizeof(d.shoeCards()[0]);
+
+    unsigned long long wideSum = 0, packedSum = 0;
+    double wideSec = timeDeals(wide, passes, wideSum);
+    double packedSec = timeDeals(packed, passes, packedSum);
+    packedSec += timeDeals(packed, passes, packedSum);
+    wideSec += timeDeals(wide, passes, wideSum);
+    const double cards = 2.0 * passes * tables;
+
+    cout << "Deck bench: " << tables << " tables x " << decks << " decks, "
+        << passes << " cards per table per run\n";
+    cout << left << setw(10) << "Layout"
+        << right << setw(14) << "KiB (calc)"
+        << right << setw(16) << "Mcards/sec"
+        << right << setw(22) << "Checksum" << "\n";
+    cout << string(10 + 14 + 16 + 22, '-') << "\n";
+    cout << fixed << setprecision(1);
+    cout << left << setw(10) << "int"
+        << right << setw(14) << wideBytes / 1024.0
+        << right << setw(16) << cards / wideSec / 1e6
+        << right << setw(22) << wideSum << "\n";
+    cout << left << setw(10) << "packed"
+        << right << setw(14) << packedBytes / 1024.0
+        << right << setw(16) << cards / packedSec / 1e6
+        << right << setw(22) << packedSum << "\n";
+    cout << string(10 + 14 + 16 + 22, '-') << "\n";
+    cout << "KiB computed as tables x a full shoe of cards, not measured\n";
+    return wideSum == packedSum ? 0 : 1;
+}
+
+/**
+ * runNumaBench(secondsPerStep, seats)
+ * -----------------------------------
+ * Steps through 1 worker and then whole nodes, running each step pinned
+ * and shared. Scaling is rounds/sec over the one-worker pinned rate.
+ */
+int runNumaBench(double secondsPerStep, int seats) {
+    if (secondsPerStep <= 0.0 || seats < 1 || seats > 7) {
+        cout << "usage: bench-numa [seconds per step > 0] [seats 1-7]\n";
+        return 1;
+    }
+    const numa::Topology& topo = numa::topology();
+    cout << "NUMA bench: " << topo.nodes.size() << " node(s), " << topo.cpuCount() << " CPU(s), "
+        << seats << " seat(s) per table, " << secondsPerStep << " s per step\n";
+    for (size_t n = 0; n < topo.nodes.size(); ++n)
+        cout << "  node " << n << ": " << topo.nodes[n].size() << " CPU(s)\n";
+
+    // (workers, nodes) steps: one worker, then every CPU of the first k nodes
+    vector<pair<size_t, size_t>> steps{ { 1, 1 } };
+    size_t cpus = 0;
+    for (size_t k = 1; k <= topo.nodes.size(); ++k) {
+        cpus += topo.nodes[k - 1].size();
+        if (cpus > 1) steps.emplace_back(cpus, k);
+    }
+
+    cout << left << setw(8) << "Nodes" << right << setw(9) << "Workers" << setw(10) << "Layout"
+        << setw(16) << "Rounds/sec" << setw(16) << "Per worker" << setw(10) << "Scaling" << "\n";
+    cout << string(8 + 9 + 10 + 16 + 16 + 10, '-') << "\n";
+    double base = 0.0;
+    for (const pair<size_t, size_t>& step : steps) {
+        for (bool pinned : { true, false }) {
+            const double rate = runStep(step.first, step.second, pinned, secondsPerStep, seats) / secondsPerStep;
+            if (base == 0.0) base = rate;
+            cout << left << setw(8) << step.second << right << setw(9) << step.first
+                << setw(10) << (pinned ? "pinned" : "shared")
+                << fixed << setprecision(0) << setw(16) << rate << setw(16) << rate / step.first
+                << setprecision(2) << setw(9) << rate / base << "x\n";
+            cout.unsetf(ios::fixed);
+        }
+    }
+    cout << string(8 + 9 + 10 + 16 + 16 + 10, '-') << "\n";
+    return 0;
+}
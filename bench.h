@@ -0,0 +1,30 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+/**
+ * Benchmarks
+ * - Command-line benchmarks run from the driver ("bench-<name> ...").
+ * - Each prints a small table to stdout and returns a process exit code.
+ *
+ * runDeckBench(tables, decks, passes)
+ *  - `tables` shoes of `decks` decks each, dealt round-robin (one card per
+ *    table per pass) the way a process hosting many tables would, comparing
+ *    the old int-per-card shoe with Deck's packed byte-per-card shoe.
+ *  - Reports shoe memory (computed from the card size) and cards/sec for
+ *    both layouts, each timed twice in int, packed, packed, int order.
+ */
+int runDeckBench(int tables, int decks, long long passes);
+
+/**
+ * runNumaBench(secondsPerStep, seats)
+ *  - Each worker plays its own `seats`-seat table with basic strategy for
+ *    `secondsPerStep`; workers = 1, then every CPU of the first 1, 2, ...
+ *    NUMA nodes.
+ *  - "pinned": each worker is pinned first and builds its own Deck, Table
+ *    and players (node-local). "shared": the same tables built by the main
+ *    thread and played by unpinned threads, the pre-NUMA layout.
+ *  - Reports rounds/sec, per worker, and scaling against one worker.
+ */
+int runNumaBench(double secondsPerStep, int seats);
+
+#endif // BENCH_H
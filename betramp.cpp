@@ -0,0 +1,160 @@
+/*
+ * Bet Ramp Optimizer Implementation
+ * ---------------------------------
+ * optimizeRamp builds the candidate list, scores it in parallel (each
+ * thread takes every n-th candidate), sorts by growth, then runs the
+ * importance-sampled ruin estimate for the leaders only.
+ */
+
+#include "betramp.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+using namespace std;
+
+/**
+ * describe()
+ * ----------
+ * One entry per bet change, e.g. "1x@<=1 3x@2 5x@3+".
+ */
+string BetRamp::describe() const {
+    ostringstream out;
+    const int lo = CountOutcomes::kMinCount;
+    for (size_t i = 0; i < bets.size(); ++i) {
+        if (i > 0 && bets[i] == bets[i - 1]) continue;
+        size_t j = i;
+        while (j + 1 < bets.size() && bets[j + 1] == bets[i]) ++j;
+        if (i > 0) out << ' ';
+        out << bets[i] << "x@";
+        if (i == 0 && j + 1 == bets.size()) out << "all";
+        else if (i == 0) out << "<=" << lo + static_cast<int>(j);
+        else if (j + 1 == bets.size()) out << lo + static_cast<int>(i) << '+';
+        else if (i == j) out << lo + static_cast<int>(i);
+        else out << lo + static_cast<int>(i) << ".." << lo + static_cast<int>(j);
+    }
+    return out.str();
+}
+
+OutcomeDistribution rampOutcomes(const CountOutcomes& counts, const BetRamp& ramp) {
+    OutcomeDistribution mix;
+    for (size_t b = 0; b < counts.byCount.size(); ++b) {
+        const OutcomeDistribution& d = counts.byCount[b];
+        for (size_t i = 0; i < d.values.size(); ++i) mix.add(d.values[i] * ramp.bets[b], d.counts[i]);
+    }
+    return mix;
+}
+
+RampResult evaluateRamp(const CountOutcomes& counts, const BetRamp& ramp, int bankroll) {
+    RampResult r;
+    r.ramp = ramp;
+    const OutcomeDistribution mix = rampOutcomes(counts, ramp);
+    r.ev = mix.mean();
+    r.sd = sqrt(mix.variance());
+    for (size_t i = 0; i < mix.values.size(); ++i) {
+        const double x = 1.0 + static_cast<double>(mix.values[i]) / bankroll;
+        r.growth += mix.probability(i) * (x > 0 ? log(x) : -1e9);
+    }
+    const long long n = counts.rounds();
+    for (size_t b = 0; b < counts.byCount.size() && n; ++b)
+        r.averageBet += static_cast<double>(counts.byCount[b].total) / n * ramp.bets[b];
+    return r;
+}
+
+// bet = 1 below start, then 1 + step * (tc - start + 1), capped at spread
+static vector<BetRamp> candidateRamps(int maxSpread) {
+    vector<BetRamp> out;
+    out.push_back(BetRamp());                                   // flat
+    for (int spread = 2; spread <= maxSpread; ++spread) {
+        for (int start = 1; start <= CountOutcomes::kMaxCount; ++start) {
+            for (int step = 1; step < spread; ++step) {
+                BetRamp r;
+                for (int tc = start; tc <= CountOutcomes::kMaxCount; ++tc)
+                    r.bets[tc - CountOutcomes::kMinCount] = min(spread, 1 + step * (tc - start + 1));
+                if (r.bets.back() == spread) out.push_back(r);   // ramps that never reach the cap repeat a smaller spread
+            }
+        }
+    }
+    return out;
+}
+
+/**
+ * optimizeRamp(counts, search)
+ * ----------------------------
+ * Scores every candidate, best growth first; the top `topWithRuin` also
+ * get a risk-of-ruin estimate over `ruinHorizon` rounds.
+ */
+vector<RampResult> optimizeRamp(const CountOutcomes& counts, const RampSearch& search) {
+    const vector<BetRamp> ramps = candidateRamps(max(search.maxSpread, 1));
+    vector<RampResult> results(ramps.size());
+
+    size_t n = search.threads > 0 ? static_cast<size_t>(search.threads) : thread::hardware_concurrency();
+    if (n == 0) n = 1;
+    n = min(n, ramps.size());
+    vector<thread> workers;
+    for (size_t t = 0; t < n; ++t) {
+        workers.emplace_back([&, t]() {
+            for (size_t i = t; i < ramps.size(); i += n)
+                results[i] = evaluateRamp(counts, ramps[i], search.bankroll);
+        });
+    }
+    for (thread& w : workers) w.join();
+
+    stable_sort(results.begin(), results.end(),
+        [](const RampResult& a, const RampResult& b) { return a.growth > b.growth; });
+
+    RuinConfig rc;
+    rc.bankroll = search.bankroll;
+    rc.horizon = search.ruinHorizon;
+    rc.paths = search.ruinPaths;
+    rc.seed = search.seed;
+    rc.threads = search.threads;
+    const size_t top = min(results.size(), static_cast<size_t>(max(search.topWithRuin, 0)));
+    for (size_t i = 0; i < top; ++i) results[i].ruin = estimateRuin(rampOutcomes(counts, results[i].ramp), rc);
+    return results;
+}
+
+/**
+ * runRampOptimizer(shoes, bankroll, maxSpread, threads, checkpointPath)
+ * ---------------------------------------------------------------------
+ * Samples 6-deck Hi-Lo outcomes once (resumably, with a checkpoint file),
+ * then prints the per-count edges and the best ramps.
+ */
+int runRampOptimizer(long long shoes, int bankroll, int maxSpread, int threads, const string& checkpointPath) {
+    if (shoes <= 0 || bankroll <= 0 || maxSpread <= 0) {
+        cout << "usage: sim-ramp [shoes] [bankroll units] [max spread] [threads] [checkpoint file]\n";
+        return 1;
+    }
+    CheckpointConfig checkpoint;
+    checkpoint.path = checkpointPath;
+    const CountOutcomes counts = sampleCountOutcomes(RuleSet(), 20250101u, 6, shoes, threads, checkpoint);
+
+    cout << "=== Hi-Lo outcomes: " << counts.rounds() << " rounds ===\n";
+    cout << fixed;
+    for (int tc = CountOutcomes::kMinCount; tc <= CountOutcomes::kMaxCount; ++tc) {
+        cout << "TC " << setw(3) << tc << ": " << setprecision(2) << setw(6) << counts.frequency(tc) * 100
+             << "% of rounds, EV " << setprecision(3) << setw(7) << counts.at(tc).mean() * 100 << "%\n";
+    }
+
+    RampSearch search;
+    search.bankroll = bankroll;
+    search.maxSpread = maxSpread;
+    search.threads = threads;
+    search.seed = 20250101u;
+    const vector<RampResult> results = optimizeRamp(counts, search);
+
+    cout << "\n=== Best of " << results.size() << " ramps (bankroll " << bankroll << " units, RoR over "
+         << search.ruinHorizon << " rounds) ===\n";
+    const size_t top = min(results.size(), static_cast<size_t>(search.topWithRuin));
+    for (size_t i = 0; i < top; ++i) {
+        const RampResult& r = results[i];
+        cout << setprecision(4) << "EV " << setw(8) << r.ev << "  SD " << setw(6) << r.sd
+             << "  avg bet " << setprecision(2) << r.averageBet
+             << "  RoR " << scientific << setprecision(2) << r.ruin.probability << fixed
+             << "  " << r.ramp.describe() << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,60 @@
+#ifndef BETRAMP_H
+#define BETRAMP_H
+
+#include <string>
+#include <vector>
+#include "ruin.h"
+#include "simulation.h"
+
+/**
+ * Bet ramps
+ * - A ramp is the bet (in table-minimum units) for each true-count bucket
+ *   of CountOutcomes.
+ * - Candidates are scored from one CountOutcomes sample: a ramp only
+ *   rescales each bucket's outcomes, so its per-round distribution is the
+ *   bucket distributions mixed with bet-scaled values; nothing is
+ *   re-simulated per candidate.
+ * - Best = highest expected log growth of the bankroll per round
+ *   (sum p(x) ln(1 + x / bankroll)), which trades EV against variance the
+ *   way Kelly betting does.
+ *
+ * Candidate family (every combination up to maxSpread):
+ *   bet = 1 below `start`, then 1 + step * (tc - start + 1), capped at spread
+ */
+struct BetRamp {
+    std::vector<int> bets = std::vector<int>(CountOutcomes::kMaxCount - CountOutcomes::kMinCount + 1, 1);
+
+    int betAt(int trueCount) const { return bets[trueCount - CountOutcomes::kMinCount]; }
+    std::string describe() const;   // "1x@<=0 2x@1 4x@2 ..."
+};
+
+struct RampResult {
+    BetRamp ramp;
+    double ev = 0.0;            // units per round
+    double sd = 0.0;            // units per round
+    double growth = 0.0;        // expected ln growth per round
+    double averageBet = 0.0;    // units
+    RuinResult ruin;            // filled for the top candidates only
+};
+
+struct RampSearch {
+    int bankroll = 1000;        // units
+    int maxSpread = 12;
+    long long ruinHorizon = 10000;
+    long long ruinPaths = 5000;
+    int topWithRuin = 5;
+    unsigned int seed = 1;
+    int threads = 0;            // 0 = all cores
+};
+
+OutcomeDistribution rampOutcomes(const CountOutcomes& counts, const BetRamp& ramp);
+RampResult evaluateRamp(const CountOutcomes& counts, const BetRamp& ramp, int bankroll);
+
+// Every candidate, best first.
+std::vector<RampResult> optimizeRamp(const CountOutcomes& counts, const RampSearch& search);
+
+// Driver mode "sim-ramp [shoes] [bankroll] [max spread] [threads] [checkpoint file]".
+int runRampOptimizer(long long shoes, int bankroll, int maxSpread, int threads,
+    const std::string& checkpointPath = "");
+
+#endif // BETRAMP_H
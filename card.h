@@ -0,0 +1,52 @@
+#ifndef CARD_H
+#define CARD_H
+
+#include <cstdint>
+#include <string>
+
+/**
+ * Card encoding
+ * - One byte per card: bits 0-3 = rank, bits 4-5 = suit.
+ *     rank 0 = Ace, 1..8 = 2..9, 9 = Ten, 10 = Jack, 11 = Queen, 12 = King
+ *     suit 0 = Spades, 1 = Clubs, 2 = Hearts, 3 = Diamonds (bit 5 set = red)
+ * - Comparing two cards is a XOR: (a ^ b) & kRankMask == 0 means same rank,
+ *   & kSuitMask == 0 same suit, & kRedBit == 0 same color.
+ * - value() gives the blackjack value (2..11) the rest of the game uses.
+ */
+namespace card {
+
+constexpr uint8_t kRankMask = 0x0F;
+constexpr uint8_t kSuitMask = 0x30;
+constexpr uint8_t kRedBit = 0x20;
+
+enum Suit { Spades = 0, Clubs, Hearts, Diamonds };
+enum Rank { Ace = 0, Ten = 9, Jack = 10, Queen = 11, King = 12 };
+
+constexpr uint8_t make(int rank, int suit) {
+    return static_cast<uint8_t>((suit << 4) | rank);
+}
+constexpr int rank(uint8_t c) { return c & kRankMask; }
+constexpr int suit(uint8_t c) { return (c & kSuitMask) >> 4; }
+
+// Blackjack value by rank (entries 13-15 unused)
+constexpr uint8_t kValue[16] = { 11, 2, 3, 4, 5, 6, 7, 8, 9, 10, 10, 10, 10, 0, 0, 0 };
+constexpr int value(uint8_t c) { return kValue[c & kRankMask]; }
+
+// Antithetic rank: A<->2, K<->3, Q<->4, J<->5, 10<->6, 9<->7, 8 stays.
+// Low cards become high ones and back, so a shoe mapped card by card keeps
+// its composition but its Hi-Lo running count flips sign at every card.
+constexpr uint8_t kMirrorRank[16] = { 1, 0, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 13, 14, 15 };
+constexpr uint8_t mirror(uint8_t c) {
+    return static_cast<uint8_t>((c & ~kRankMask) | kMirrorRank[c & kRankMask]);
+}
+
+// "QH", "10S", "AD", ...
+inline std::string name(uint8_t c) {
+    static const char* ranks[13] = { "A", "2", "3", "4", "5", "6", "7", "8", "9", "10", "J", "Q", "K" };
+    static const char suits[4] = { 'S', 'C', 'H', 'D' };
+    return std::string(ranks[rank(c)]) + suits[suit(c)];
+}
+
+} // namespace card
+
+#endif // CARD_H
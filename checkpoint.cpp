@@ -0,0 +1,103 @@
+/*
+ * Checkpoint Implementation
+ * -------------------------
+ * File layout: magic, version, kind, payload size (u32 each), fingerprint,
+ * progress (u64 each), payload, then an FNV-1a checksum of everything
+ * before it.
+ */
+
+#include "checkpoint.h"
+#include <cstdio>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+constexpr uint64_t kFnvBasis = 0xCBF29CE484222325ULL;
+constexpr uint64_t kFnvPrime = 0x100000001B3ULL;
+
+uint64_t fnv(uint64_t h, const void* data, size_t n) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < n; ++i) h = (h ^ p[i]) * kFnvPrime;
+    return h;
+}
+
+struct FileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t kind;
+    uint32_t payload;
+    uint64_t fingerprint;
+    int64_t progress;
+};
+
+} // namespace
+
+uint64_t Checkpoint::fingerprint(initializer_list<uint64_t> settings) {
+    uint64_t h = kFnvBasis;
+    for (uint64_t s : settings) h = fnv(h, &s, sizeof(s));
+    return h;
+}
+
+/**
+ * save(path, kind, fingerprint, progress)
+ * ---------------------------------------
+ * Writes <path>.tmp, then replaces <path> with it in one step: rename()
+ * on POSIX, MoveFileEx with MOVEFILE_REPLACE_EXISTING on Windows (where
+ * rename() refuses an existing target). There is no moment at which
+ * neither file is complete.
+ */
+bool Checkpoint::save(const string& path, uint32_t kind, uint64_t fp, long long progress) const {
+    const FileHeader h{ kMagic, kVersion, kind, static_cast<uint32_t>(bytes.size()), fp, progress };
+    uint64_t sum = fnv(kFnvBasis, &h, sizeof(h));
+    sum = fnv(sum, bytes.data(), bytes.size());
+
+    const string tmp = path + ".tmp";
+    FILE* f = fopen(tmp.c_str(), "wb");
+    if (!f) return false;
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1
+        && fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size()
+        && fwrite(&sum, sizeof(sum), 1, f) == 1;
+    ok = fclose(f) == 0 && ok;
+    if (!ok) { remove(tmp.c_str()); return false; }
+#ifdef _WIN32
+    ok = MoveFileExA(tmp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    ok = rename(tmp.c_str(), path.c_str()) == 0;
+#endif
+    if (!ok) remove(tmp.c_str());
+    return ok;
+}
+
+/**
+ * load(path, kind, fingerprint, progress)
+ * ---------------------------------------
+ * Replaces the payload with the file's (read it back with read()) if the
+ * file is a complete checkpoint of this kind and fingerprint.
+ */
+bool Checkpoint::load(const string& path, uint32_t kind, uint64_t fp, long long& progress) {
+    clear();
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    FileHeader h;
+    uint64_t sum = 0;
+    bool ok = fread(&h, sizeof(h), 1, f) == 1
+        && h.magic == kMagic && h.version == kVersion && h.kind == kind && h.fingerprint == fp
+        && h.progress >= 0;
+    if (ok) {
+        bytes.resize(h.payload);
+        ok = fread(&bytes[0], 1, bytes.size(), f) == bytes.size()
+            && fread(&sum, sizeof(sum), 1, f) == 1
+            && fgetc(f) == EOF
+            && sum == fnv(fnv(kFnvBasis, &h, sizeof(h)), bytes.data(), bytes.size());
+    }
+    fclose(f);
+    if (!ok) { clear(); return false; }
+    progress = h.progress;
+    return true;
+}
@@ -0,0 +1,154 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Checkpoint
+ * - Progress file for long simulations: which run it belongs to (kind tag
+ *   + fingerprint of every setting that changes results), how far it got,
+ *   and the accumulated statistics as raw bytes. Doubles are stored by bit
+ *   pattern, so a resumed run continues from exactly the same sums.
+ * - save() writes <path>.tmp and atomically renames it over <path>: a run
+ *   killed mid-save still has the previous checkpoint. A trailing checksum
+ *   rejects torn or foreign files; load() then returns false and the run
+ *   starts over.
+ * - Host byte order: a checkpoint is resumed on the machine that wrote it.
+ *
+ * Shoe-indexed simulations need no RNG or shoe-position state beyond the
+ * progress: shoe #k is rebuilt from (seed, k) by Deck::loadShoe, and every
+ * batch ends on a shoe boundary.
+ */
+class Checkpoint {
+public:
+    static constexpr uint32_t kMagic = 0x4B435043;   // "CPCK"
+    static constexpr uint32_t kVersion = 1;
+
+    template <class T>
+    void write(const T& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "plain values only");
+        bytes.append(reinterpret_cast<const char*>(&v), sizeof(T));
+    }
+    template <class T>
+    void write(const std::vector<T>& v) {
+        write(static_cast<uint64_t>(v.size()));
+        for (const T& x : v) write(x);
+    }
+
+    // false once the payload runs out (the value is left unchanged)
+    template <class T>
+    bool read(T& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "plain values only");
+        if (bytes.size() - cursor < sizeof(T)) return false;
+        std::memcpy(&v, bytes.data() + cursor, sizeof(T));
+        cursor += sizeof(T);
+        return true;
+    }
+    template <class T>
+    bool read(std::vector<T>& v) {
+        uint64_t n = 0;
+        if (!read(n) || n > (bytes.size() - cursor) / sizeof(T)) return false;
+        v.resize(static_cast<size_t>(n));
+        for (T& x : v) if (!read(x)) return false;
+        return true;
+    }
+    bool atEnd() const { return cursor == bytes.size(); }
+
+    void clear() { bytes.clear(); cursor = 0; }
+    size_t size() const { return bytes.size(); }
+
+    bool save(const std::string& path, uint32_t kind, uint64_t fingerprint, long long progress) const;
+    bool load(const std::string& path, uint32_t kind, uint64_t fingerprint, long long& progress);
+
+    // FNV-1a over the settings that identify a run
+    static uint64_t fingerprint(std::initializer_list<uint64_t> settings);
+
+private:
+    std::string bytes;
+    size_t cursor = 0;
+};
+
+// Checkpoint kinds (one per simulation that can resume).
+enum CheckpointKind : uint32_t {
+    CheckpointPairedSim = 1,
+    CheckpointOutcomes,
+    CheckpointCountOutcomes,
+    CheckpointDeviation
+};
+
+// Where and how often a simulation checkpoints (empty path = never).
+struct CheckpointConfig {
+    std::string path;
+    double everySeconds = 30.0;
+};
+
+struct CheckpointStats {
+    long long resumedAt = 0;        // shoes already done when the run started
+    long long aheadAt = 0;          // progress of a checkpoint past `shoes` (ignored, kept)
+    int saves = 0;
+    int failedSaves = 0;            // could not write the file (the run goes on)
+    double saveSeconds = 0.0;
+    double runSeconds = 0.0;
+
+    double overhead() const { return runSeconds > 0 ? saveSeconds / runSeconds : 0.0; }
+};
+
+/**
+ * runShoeBatches(cfg, kind, fingerprint, shoes, batchShoes, save, load, play)
+ * - Plays shoes 1..shoes as play(first, last) over consecutive batches of
+ *   batchShoes, picking up after the progress in cfg.path when that holds a
+ *   matching checkpoint that load(Checkpoint&) accepts (load reads into
+ *   temporaries and only keeps them if the whole payload parsed).
+ * - The shoe count is not part of the fingerprint, so that a longer run
+ *   can extend a shorter one. A checkpoint that is already past `shoes`
+ *   can't be cut back to it: the run starts from shoe 1, never saves (the
+ *   longer checkpoint stays as it is) and reports it in aheadAt.
+ * - After a batch, saves (save(Checkpoint&) appends the sums) once
+ *   cfg.everySeconds have passed since the last save, and after the last
+ *   batch, so a later run with more shoes can extend this one.
+ * - Callers accumulate in shoe order, so where the run was interrupted
+ *   never changes the result.
+ */
+template <class Save, class Load, class Play>
+CheckpointStats runShoeBatches(const CheckpointConfig& cfg, uint32_t kind, uint64_t fingerprint,
+    long long shoes, long long batchShoes, Save save, Load load, Play play) {
+    using Clock = std::chrono::steady_clock;
+    const auto seconds = [](Clock::duration d) { return std::chrono::duration<double>(d).count(); };
+    const Clock::time_point start = Clock::now();
+
+    CheckpointStats stats;
+    Checkpoint data;
+    long long done = 0;
+    if (!cfg.path.empty() && data.load(cfg.path, kind, fingerprint, done)) {
+        if (done > shoes) stats.aheadAt = done;
+        else if (load(data)) stats.resumedAt = done;
+        if (stats.resumedAt == 0) done = 0;
+    }
+
+    const long long batch = batchShoes > 0 ? batchShoes : 1;
+    Clock::time_point lastSave = Clock::now();
+    while (done < shoes) {
+        const long long last = done + batch < shoes ? done + batch : shoes;
+        play(done + 1, last);
+        done = last;
+        if (cfg.path.empty() || stats.aheadAt > 0) continue;
+        const Clock::time_point now = Clock::now();
+        if (done < shoes && seconds(now - lastSave) < cfg.everySeconds) continue;
+        data.clear();
+        save(data);
+        if (data.save(cfg.path, kind, fingerprint, done)) ++stats.saves;
+        else ++stats.failedSaves;
+        lastSave = Clock::now();
+        stats.saveSeconds += seconds(lastSave - now);
+    }
+    stats.runSeconds = seconds(Clock::now() - start);
+    return stats;
+}
+
+#endif // CHECKPOINT_H
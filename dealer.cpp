@@ -18,22 +18,30 @@
  */
 
 #include "dealer.h"
+#include "card.h"
+#include "stats.h"
 #include <iostream>
 
 using std::cout;
 using std::endl;
 
 /**
- * playHand(deck)
- * --------------
+ * playHand(deck, drawn)
+ * ---------------------
  * Controls the dealer's turn logic.
  * - Continues drawing cards until reaching a total of 17 or higher.
  * - If the hand is a "soft 17" (Ace counted as 11),
  *   behavior depends on 'hitSoft17' (true = hit, false = stand).
  *
  * The method exits automatically once the dealer must stand.
+ * Every card drawn is appended to `drawn` (rank + suit code) when given.
  */
-void Dealer::playHand(Deck& deck) {
+void Dealer::playHand(Deck& deck, std::vector<uint8_t>* drawn) {
+    auto hit = [&]() {
+        const uint8_t code = deck.dealCard();
+        if (drawn) drawn->push_back(code);
+        cardDealt(card::value(code));
+    };
     while (true) {
         int total = handValue();
 
@@ -44,7 +52,8 @@ void Dealer::playHand(Deck& deck) {
         // decide based on the hitSoft17 rule.
         if (total == 17 && isSoft()) {
             if (hitSoft17) {
-                cardDealt(deck.deal());  // Dealer hits soft 17
+                hit();                   // Dealer hits soft 17
+                CLUB_STAT_INC(DealerHits);
                 continue;                // Check new total
             }
             else {
@@ -54,13 +63,16 @@ void Dealer::playHand(Deck& deck) {
 
         // Hit on totals of 16 or less
         if (total <= 16) {
-            cardDealt(deck.deal());
+            hit();
+            CLUB_STAT_INC(DealerHits);
             continue;
         }
 
         // Default case: stop drawing
         break;
     }
+
+    if (handValue() > 21) CLUB_STAT_INC(DealerBusts);
 }
 
 /**
@@ -99,63 +111,3 @@ bool Dealer::isBlackjack() const {
     if (hand.size() != 2) return false;
     return handValue() == 21;
 }
-
-/**
- * isSoft()
- * ---------
- * Determines whether the dealers hand is "soft."
- * A hand is considered soft if it contains at least one Ace counted as 11
- * without the total exceeding 21.
- *
- * Example:
- *   A + 6 = soft 17 (true)
- *   A + 6 + 10 = hard 17 (false)
- *
- * Implementation notes:
- * - Counts aces as 11 initially, reducing them to 1 as needed to avoid busts.
- * - Returns true if at least one Ace remains valued at 11 after adjustments.
- */
-bool Dealer::isSoft() const {
-    int sum = 0;
-    int aces = 0;
-
-    // Step 1: Count all aces as 11 initially
-    for (int v : hand) {
-        if (v == 11) {
-            ++aces;
-            sum += 11;
-        }
-        else {
-            sum += v;
-        }
-    }
-
-    // Step 2: Reduce Aces (subtract 10) while sum > 21
-    while (sum > 21 && aces > 0) {
-        sum -= 10;
-        --aces;
-    }
-
-    // Step 3: Recompute total to determine if any Ace remains as 11
-    int recompute = 0;
-    int aces2 = 0;
-    for (int v : hand) {
-        if (v == 11) {
-            ++aces2;
-            recompute += 11;
-        }
-        else {
-            recompute += v;
-        }
-    }
-
-    int reduced = 0;
-    while (recompute > 21 && aces2 > 0) {
-        recompute -= 10;
-        --aces2;
-        ++reduced;
-    }
-
-    // Step 4: If any ace still counted as 11 and total <= 21, it's soft.
-    return (aces2 > 0 && recompute <= 21);
-}
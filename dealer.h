@@ -13,11 +13,12 @@
  * - No bankroll/betting  the Table handles settlements against Players
  *
  * Helpers:
- *  - playHand(Deck&): play out the dealer's hand per rules
+ *  - playHand(Deck&, drawn): play out the dealer's hand per rules
+ *    (drawn, if given, gets the code of every card drawn)
  *  - upCardValue(): value of the first (up) card; -1 if none
  *  - showUpCard(): print "[<upcard>, ?]"
  *  - isBlackjack(): true if exactly 2 cards totaling 21
- *  - isSoft(): true if current total uses Ace as 11 (i.e., a "soft" total)
+ *  - isSoft(): inherited from Person; true if an Ace is counted as 11
  *  - setHitSoft17(bool): allow switching rules (default: stand on all 17)
  */
 class Dealer : public Person {
@@ -26,7 +27,7 @@ public:
     ~Dealer() override = default;
 
     // Core play logic (hit on 16, stand on 17; optionally hit soft 17)
-    void playHand(Deck& deck);
+    void playHand(Deck& deck, std::vector<uint8_t>* drawn = nullptr);
 
     // Rule configuration (default false = stand on soft 17)
     void setHitSoft17(bool enable) { hitSoft17 = enable; }
@@ -36,7 +37,6 @@ public:
     int  upCardValue() const;   // -1 if no cards in hand
     void showUpCard() const;    // prints "Dealer shows: [<up>, ?]"
     bool isBlackjack() const;   // exactly 2 cards, total 21
-    bool isSoft() const;        // true if an Ace is counted as 11 in current total
 
 private:
     // If true, dealer will hit soft 17 (A+6). Default is false (stand on any 17).
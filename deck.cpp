@@ -1,50 +1,93 @@
 #include "deck.h"
+#include "card.h"
+#include "stats.h"
+#include "shoe_pipeline.h"
 #include<algorithm>
 #include<random>
-Deck::Deck() : shoe() {}
-//fills and shuffle a vector with card values 2-11
-void Deck::shuffle() {
-    shoe.clear(); //clear vector if you need to reshuffle and the vector isn't empty
-    //insert values 2-9 with for loops
-    for (int cardValue = 2; cardValue <= 9; cardValue++) {
-        for (int i = 0; i < 4; i++) {
-            shoe.push_back(cardValue);
+Deck::Deck() : shoe(), seed(std::random_device{}()) {}
+Deck::Deck(unsigned int inSeed, int inDecks) : shoe(), seed(inSeed), decks(inDecks < 1 ? 1 : inDecks) {}
+//mixes the base seed and shoe number (splitmix64 finalizer) so every shoe gets its own stream
+unsigned int Deck::shoeSeed(unsigned int baseSeed, int shoeIndex) {
+    unsigned long long z = (static_cast<unsigned long long>(baseSeed) << 32) + static_cast<unsigned int>(shoeIndex);
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return static_cast<unsigned int>(z ^ (z >> 31));
+}
+//uniform draw in [0, bound) from 32-bit engine output (Lemire's multiply-shift, rejecting the biased low products)
+//so the shuffle is the same with every standard library, unlike std::shuffle + uniform_int_distribution
+static uint32_t boundedDraw(std::mt19937& rng, uint32_t bound) {
+    uint64_t m = static_cast<uint64_t>(static_cast<uint32_t>(rng())) * bound;
+    if (static_cast<uint32_t>(m) < bound) {
+        const uint32_t threshold = (0u - bound) % bound;
+        while (static_cast<uint32_t>(m) < threshold)
+            m = static_cast<uint64_t>(static_cast<uint32_t>(rng())) * bound;
+    }
+    return static_cast<uint32_t>(m >> 32);
+}
+//builds shoe #shoeIndex for a seed: all 52 rank/suit codes for every deck, then a seeded shuffle
+//(static so the shoe pipeline's producer thread builds exactly the same shoes)
+void Deck::buildShoe(vector<uint8_t>& out, unsigned int baseSeed, int numDecks, int shoeIndex) {
+    out.clear(); //clear vector if you need to reshuffle and the vector isn't empty
+    for (int d = 0; d < numDecks; d++) {
+        for (int suit = 0; suit < 4; suit++) {
+            for (int rank = 0; rank < 13; rank++) {
+                out.push_back(card::make(rank, suit));
+            }
         }
     }
-    //insert 10 values
-    for (int i = 0; i < 16; i++) {
-        shoe.push_back(10);
+    //Fisher-Yates: swap each position from the back with a uniformly drawn one at or before it
+    //the engine is seeded per shoe so any shoe can be rebuilt from (seed, shuffleCount)
+    std::mt19937 rng(shoeSeed(baseSeed, shoeIndex));
+    for (size_t i = out.size(); i > 1; --i) {
+        std::swap(out[i - 1], out[boundedDraw(rng, static_cast<uint32_t>(i))]);
     }
-    //insert 11 values for aces
-    for (int i = 0; i < 4; i++) {
-        shoe.push_back(11);
+}
+//fills and shuffle the shoe in place
+void Deck::shuffle() {
+    ++shuffles;
+    buildShoe(shoe, seed, decks, shuffles);
+}
+//builds shoe #shoeIndex directly, so simulations can replay any shoe
+//(mirrored: the same shuffle with ranks swapped high<->low, the antithetic twin of that shoe)
+void Deck::loadShoe(int shoeIndex, bool mirrored) {
+    shuffles = shoeIndex;
+    buildShoe(shoe, seed, decks, shoeIndex);
+    if (mirrored) {
+        for (uint8_t& c : shoe) c = card::mirror(c);
     }
-    //I found this code from a stack overflow page here "https://stackoverflow.com/questions/6926433/how-to-shuffle-a-stdvector"
-    //The first line grabs a rng engine, and the second line is a shuffle function using the rng engine
-    static std::mt19937 rng(std::random_device{}());
-    std::shuffle(shoe.begin(), shoe.end(), rng);
+}
+//takes the next pre-shuffled shoe from the pipeline (O(1) swap); shuffles in place only if none is ready
+void Deck::nextShoe() {
+    if (pipeline && pipeline->takeShoe(shoe, shuffles + 1)) {
+        ++shuffles;
+        return;
+    }
+    CLUB_STAT_INC(ReshuffleStalls);
+    shuffle();
 }
 //this will deal 1 card per call, if the shoe vector is empty it will refill, shuffle, then deal
-int Deck::deal() {
+uint8_t Deck::dealCard() {
+    CLUB_STAT_INC(CardsDealt);
     if (shoe.empty()) {
-        shuffle();
-        int card = shoe.back();
-        shoe.pop_back();
-        return card;
-    }
-    else {
-        int card = shoe.back();
-        shoe.pop_back();
-        return card;
+        CLUB_STAT_INC(Reshuffles);
+        nextShoe();
     }
+    uint8_t code = shoe.back();
+    shoe.pop_back();
+    return code;
 }
-//will return the current shoe, if shoe is empty will return a full shuffled shoe
+//same as dealCard() but returns the blackjack value (one table lookup)
+int Deck::deal() {
+    return card::value(dealCard());
+}
+//will return the current shoe as card values, if shoe is empty will return a full shuffled shoe
 vector<int> Deck::viewDeck() {
     if (shoe.empty()) {
         shuffle();
-        return shoe;
-    }
-    else {
-        return shoe;
     }
+    vector<int> values;
+    values.reserve(shoe.size());
+    for (uint8_t code : shoe) values.push_back(card::value(code));
+    return values;
 }
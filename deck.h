@@ -1,17 +1,38 @@
 #ifndef DECK_H
 #define DECK_H
 #include<vector>
+#include<cstdint>
 using namespace std;
+class ShoePipeline;
 //Deck class header file
 class Deck
 {
 private:
-    vector<int> shoe;
+    vector<uint8_t> shoe;//card codes (rank + suit, see card.h), one byte each (an 8-deck shoe is 416 bytes)
+    int shuffles = 0;
+    unsigned int seed;//base seed, every shoe is derived from it
+    int decks = 1;//decks per shoe
+    ShoePipeline* pipeline = nullptr;//optional source of pre-shuffled shoes
+    void nextShoe();//swaps in the next shoe when the current one runs dry
 public:
-    Deck();
+    Deck();//random seed
+    explicit Deck(unsigned int inSeed, int inDecks = 1);//same seed -> same sequence of shoes
     void shuffle();//will build and shuffle a deck of cards
-    int deal();//deals 1 card per call
-    vector<int> viewDeck();//will return the current deck
+    int deal();//deals 1 card per call, as its blackjack value 2-11
+    uint8_t dealCard();//deals 1 card per call, as its rank + suit code (for side bets)
+    vector<int> viewDeck();//will return the current deck (card values)
+    size_t cardsRemaining() const { return shoe.size(); }//cards left before the next reshuffle
+    int shuffleCount() const { return shuffles; }//how many shoes have been built so far
+    unsigned int getSeed() const { return seed; }
+    int deckCount() const { return decks; }
+    size_t shoeSize() const { return static_cast<size_t>(decks) * 52; }
+    size_t shoePosition() const { return shuffles ? shoeSize() - shoe.size() : 0; }//cards dealt from the current shoe
+    void attachPipeline(ShoePipeline* p) { pipeline = p; }//nullptr = always shuffle in place
+    void loadShoe(int shoeIndex, bool mirrored = false);//jumps straight to shoe #shoeIndex (mirrored = every card through card::mirror)
+    const vector<uint8_t>& shoeCards() const { return shoe; }//remaining card codes, next card dealt is back()
+    void loadCards(const vector<uint8_t>& codes) { shoe = codes; }//stacks the shoe with exact cards (simulations, tests)
+    static unsigned int shoeSeed(unsigned int baseSeed, int shoeIndex);//rng seed used for shoe #shoeIndex
+    static void buildShoe(vector<uint8_t>& out, unsigned int baseSeed, int numDecks, int shoeIndex);//fills + shuffles shoe #shoeIndex
 };
 
 #endif // DECK_H
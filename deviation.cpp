@@ -0,0 +1,261 @@
+/*
+ * Deviation Index Generator Implementation
+ * ----------------------------------------
+ * Work is split by shoe like the other simulations: shoes are played in
+ * batches, inside a batch pinned thread t takes shoes t, t + threads, ...
+ * and keeps private sums for every cell, allocated on its own node; the
+ * sums are merged and checkpointed after each batch (runShoeBatches,
+ * checkpoint.h).
+ */
+
+#include "deviation.h"
+#include "card.h"
+#include "dealer.h"
+#include "deck.h"
+#include "player.h"
+#include "strategy.h"
+#include "table.h"
+#include "numa.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <utility>
+
+using namespace std;
+
+namespace {
+
+constexpr int kBuckets = DeviationCell::kMaxCount - DeviationCell::kMinCount + 1;
+constexpr int kCells = 5 * 10;   // hard 12..16 x dealer 2..11
+
+int hiLoTag(int value) { return value <= 6 ? 1 : (value >= 10 ? -1 : 0); }
+
+size_t countBucket(double trueCount) {
+    const int tc = static_cast<int>(floor(trueCount));
+    return static_cast<size_t>(min(max(tc, DeviationCell::kMinCount), DeviationCell::kMaxCount) - DeviationCell::kMinCount);
+}
+
+// Takes one card of blackjack value `value` out of the shoe copy (the
+// deepest one, so the next cards to be dealt keep their order).
+bool removeValue(vector<uint8_t>& cards, int value) {
+    for (size_t i = 0; i < cards.size(); ++i) {
+        if (card::value(cards[i]) == value) {
+            cards.erase(cards.begin() + static_cast<long>(i));
+            return true;
+        }
+    }
+    return false;
+}
+
+// Plays the cell once on the stacked deck: player hard `total` (10 + x)
+// vs dealer `up`; result in units for the player.
+int playCell(Deck& deck, Dealer& dealer, Player& hand, int total, int up, bool hit) {
+    hand.clearHand();
+    dealer.clearHand();
+    hand.cardDealt(10);
+    hand.cardDealt(total - 10);
+    dealer.cardDealt(up);
+    dealer.cardDealt(deck.deal());   // hole card is dealt before the player acts
+
+    if (hit) {
+        hand.cardDealt(deck.deal());
+        BasicStrategy basic;
+        while (hand.handValue() < 21) {
+            HandContext c;
+            c.total = hand.handValue();
+            c.soft = hand.isSoft();
+            c.dealerUp = up;
+            if (!basic.shouldHit(c)) break;
+            hand.cardDealt(deck.deal());
+        }
+        if (hand.handValue() > 21) return -1;
+    }
+
+    dealer.playHand(deck);
+    const int d = dealer.handValue();
+    const int p = hand.handValue();
+    if (d > 21 || p > d) return 1;
+    return p < d ? -1 : 0;
+}
+
+// Per-worker sums, cell-major
+using CellSums = vector<RunningStat>;
+
+void playShoes(const DeviationConfig& cfg, long long first, long long last, size_t step, CellSums& sums) {
+    Deck deck(cfg.seed, cfg.decks);
+    Table table(deck);
+    Player seat("index", 1 << 30);
+    seat.setBet(1);
+    table.addPlayer(&seat);
+    table.setHitSoft17(cfg.rules.hitSoft17);
+    HiLoCounting counter;
+    RoundResult result;
+
+    Deck scratch(cfg.seed, cfg.decks);
+    Dealer dealer;
+    dealer.setHitSoft17(cfg.rules.hitSoft17);
+    Player hand("cell", 0);
+    vector<uint8_t> work;
+
+    const int rounds = roundsPerShoe(cfg.decks);
+    for (long long k = first; k <= last; k += static_cast<long long>(step)) {
+        deck.loadShoe(static_cast<int>(k));
+        for (int r = 0; r < rounds; ++r) {
+            const int running = counter.shoeId == deck.shuffleCount() ? counter.runningCount : 0;
+            const vector<uint8_t>& snapshot = deck.shoeCards();
+            for (int c = 0; c < kCells; ++c) {
+                const int total = 12 + c / 10;
+                const int up = 2 + c % 10;
+                work = snapshot;
+                if (!removeValue(work, 10) || !removeValue(work, total - 10) || !removeValue(work, up)) continue;
+
+                const double decksLeft = max(static_cast<double>(work.size()) / 52.0, 0.5);
+                const double tc = (running + hiLoTag(10) + hiLoTag(total - 10) + hiLoTag(up)) / decksLeft;
+
+                scratch.loadCards(work);
+                const int stand = playCell(scratch, dealer, hand, total, up, false);
+                scratch.loadCards(work);
+                const int hit = playCell(scratch, dealer, hand, total, up, true);
+                sums[static_cast<size_t>(c) * kBuckets + countBucket(tc)].add(hit - stand);
+            }
+            table.playRounds(1, counter, &result);
+        }
+    }
+}
+
+void saveSums(Checkpoint& c, const DeviationTable& table) {
+    for (const DeviationCell& cell : table.cells) c.write(cell.byCount);
+}
+
+bool loadSums(Checkpoint& c, DeviationTable& table) {
+    vector<vector<RunningStat>> sums(table.cells.size());
+    for (vector<RunningStat>& s : sums)
+        if (!c.read(s) || s.size() != static_cast<size_t>(kBuckets)) return false;
+    if (!c.atEnd()) return false;
+    for (size_t i = 0; i < sums.size(); ++i) table.cells[i].byCount = sums[i];
+    return true;
+}
+
+} // namespace
+
+/**
+ * fitIndex(minSamples)
+ * --------------------
+ * Buckets with at least minSamples samples, weighted by n / variance.
+ */
+void DeviationCell::fitIndex(long long minSamples) {
+    double s = 0, sx = 0, sxx = 0, sy = 0, sxy = 0;
+    int points = 0;
+    for (size_t b = 0; b < byCount.size(); ++b) {
+        const RunningStat& st = byCount[b];
+        const double var = st.variance();
+        if (st.n < minSamples || var <= 0) continue;
+        const double w = st.n / var;
+        const double x = kMinCount + static_cast<int>(b);
+        const double y = st.mean();
+        s += w; sx += w * x; sxx += w * x * x; sy += w * y; sxy += w * x * y;
+        ++points;
+    }
+    found = false;
+    const double det = s * sxx - sx * sx;
+    if (points < 2 || det <= 0) return;
+    const double slope = (s * sxy - sx * sy) / det;
+    const double intercept = (sy - slope * sx) / s;
+    if (slope == 0) return;
+
+    index = -intercept / slope;
+    const double varA = sxx / det, varB = s / det, cov = -sx / det;
+    const double se = sqrt(max(varA + index * index * varB + 2 * index * cov, 0.0)) / fabs(slope);
+    low = index - 1.96 * se;
+    high = index + 1.96 * se;
+    found = index >= kMinCount && index <= kMaxCount;
+}
+
+/**
+ * generateDeviationIndices(cfg)
+ * -----------------------------
+ * Resumes from cfg.statePath when it matches, plays the remaining shoes
+ * in batches, and fits every cell at the end.
+ */
+DeviationTable generateDeviationIndices(const DeviationConfig& cfg) {
+    DeviationTable table;
+    for (int c = 0; c < kCells; ++c) {
+        DeviationCell cell;
+        cell.total = 12 + c / 10;
+        cell.dealerUp = 2 + c % 10;
+        table.cells.push_back(cell);
+    }
+
+    // a checkpoint after every batch; resumable runs must keep seed, decks and rules
+    CheckpointConfig checkpoint;
+    checkpoint.path = cfg.statePath;
+    checkpoint.everySeconds = 0.0;
+    const uint64_t fingerprint = Checkpoint::fingerprint({ cfg.seed, static_cast<uint64_t>(cfg.decks),
+        cfg.rules.hitSoft17 ? 1u : 0u });
+
+    size_t n = cfg.threads > 0 ? static_cast<size_t>(cfg.threads) : thread::hardware_concurrency();
+    if (n == 0) n = 1;
+    const CheckpointStats stats = runShoeBatches(checkpoint, CheckpointDeviation, fingerprint, cfg.shoes, cfg.batchShoes,
+        [&](Checkpoint& c) { saveSums(c, table); },
+        [&](Checkpoint& c) { return loadSums(c, table); },
+        [&](long long first, long long last) {
+            const size_t workers = min(n, static_cast<size_t>(last - first + 1));
+            vector<CellSums> partial(workers);
+            numa::runPinned(workers, [&](size_t t) {
+                CellSums local(static_cast<size_t>(kCells) * kBuckets);
+                playShoes(cfg, first + static_cast<long long>(t), last, workers, local);
+                partial[t] = move(local);
+            });
+
+            for (const CellSums& sums : partial)
+                for (size_t i = 0; i < sums.size(); ++i) table.cells[i / kBuckets].byCount[i % kBuckets].merge(sums[i]);
+        });
+    table.shoesDone = cfg.shoes;
+    if (stats.failedSaves) cerr << "(could not save index state to " << cfg.statePath << ")\n";
+    if (stats.aheadAt) cerr << "(" << cfg.statePath << " is already at shoe " << stats.aheadAt << "; left as it is)\n";
+
+    for (DeviationCell& cell : table.cells) cell.fitIndex();
+    return table;
+}
+
+/**
+ * runDeviationTool(shoes, threads, statePath)
+ * -------------------------------------------
+ * 6 decks, stand on soft 17. Prints the index grid ("stand at TC >= x";
+ * "." = no crossover in range) and the bounds for each found index.
+ */
+int runDeviationTool(long long shoes, int threads, const string& statePath) {
+    if (shoes <= 0) {
+        cout << "usage: sim-index [shoes] [threads] [state file]\n";
+        return 1;
+    }
+    DeviationConfig cfg;
+    cfg.seed = 20250101u;
+    cfg.shoes = shoes;
+    cfg.threads = threads;
+    cfg.statePath = statePath;
+    const DeviationTable t = generateDeviationIndices(cfg);
+
+    cout << "=== Hi-Lo stand/hit indices: " << t.shoesDone << " shoes (stand at TC >= index) ===\n";
+    cout << "     ";
+    for (int up = 2; up <= 11; ++up) cout << setw(6) << (up == 11 ? string("A") : to_string(up));
+    cout << "\n" << fixed << setprecision(1);
+    for (int total = 16; total >= 12; --total) {
+        cout << "H" << setw(2) << total << "  ";
+        for (int up = 2; up <= 11; ++up) {
+            const DeviationCell& c = t.cell(total, up);
+            if (c.found) cout << setw(6) << showpos << c.index << noshowpos;
+            else cout << setw(6) << ".";
+        }
+        cout << "\n";
+    }
+    cout << "\n95% bounds:\n";
+    for (const DeviationCell& c : t.cells) {
+        if (!c.found) continue;
+        cout << "  " << c.total << " vs " << (c.dealerUp == 11 ? string("A") : to_string(c.dealerUp))
+             << ": " << showpos << c.index << " [" << c.low << ", " << c.high << "]" << noshowpos << "\n";
+    }
+    return 0;
+}
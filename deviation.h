@@ -0,0 +1,66 @@
+#ifndef DEVIATION_H
+#define DEVIATION_H
+
+#include <string>
+#include <vector>
+#include "simulation.h"
+
+/**
+ * Deviation index generator
+ * - For every hard 12-16 vs dealer 2-A cell, finds the Hi-Lo true count
+ *   at which hitting and standing are worth the same.
+ * - Samples come from real shoe states: a counting seat plays shoes
+ *   through the Table, and before each round the remaining cards are
+ *   copied. Each cell then takes its three cards out of that copy and plays
+ *   the hand twice on the same remaining cards (common random numbers):
+ *   once standing, once hitting and continuing with basic strategy.
+ *   The sample is result(hit) - result(stand), bucketed by the floored
+ *   true count including the cell's cards.
+ * - Index: weighted least-squares line through the bucket means, solved for
+ *   zero; the bounds come from the fit's standard errors (delta method).
+ *   Above the index standing is better.
+ *
+ * Resumable: the accumulated sums and the next shoe number are saved to
+ * `statePath` after every batch, and a run with the same seed/decks/rules
+ * picks up from there.
+ */
+struct DeviationConfig {
+    RuleSet rules;
+    unsigned int seed = 1;
+    int decks = 6;
+    long long shoes = 20000;
+    long long batchShoes = 2000;    // shoes between state saves
+    int threads = 0;                // 0 = all cores
+    std::string statePath;          // empty = not resumable
+};
+
+struct DeviationCell {
+    static constexpr int kMinCount = -8;
+    static constexpr int kMaxCount = 12;
+
+    int total = 0;                  // hard 12..16
+    int dealerUp = 0;               // 2..11
+    std::vector<RunningStat> byCount = std::vector<RunningStat>(kMaxCount - kMinCount + 1);
+
+    // filled by fitIndex()
+    bool found = false;             // crossover inside [kMinCount, kMaxCount]
+    double index = 0.0;
+    double low = 0.0;               // ~95% bounds
+    double high = 0.0;
+
+    void fitIndex(long long minSamples = 200);
+};
+
+struct DeviationTable {
+    long long shoesDone = 0;
+    std::vector<DeviationCell> cells;   // total-major: 12 vs 2, 12 vs 3, ...
+
+    const DeviationCell& cell(int total, int dealerUp) const { return cells[(total - 12) * 10 + (dealerUp - 2)]; }
+};
+
+DeviationTable generateDeviationIndices(const DeviationConfig& cfg);
+
+// Driver mode "sim-index [shoes] [threads] [state file]".
+int runDeviationTool(long long shoes, int threads, const std::string& statePath);
+
+#endif // DEVIATION_H
@@ -0,0 +1,149 @@
+/*
+ * Endgame Solver Implementation
+ * -----------------------------
+ * Hands are tracked as their value plus the aces still counted as 11
+ * (0 or 1 once demoted); a drawn card is added to both and the pair is
+ * valued again with Hand's rule (Hand::valueOf / softOf: aces drop to 1
+ * one at a time while over 21).
+ * Memo keys: 6 bits per card value (60 bits, bit 63 = infinite shoe) and
+ * the hand state.
+ */
+
+#include "endgame.h"
+#include "card.h"
+#include "deck.h"
+#include "player.h"
+#include "table.h"
+
+namespace {
+
+constexpr uint64_t kInfiniteKey = 1ULL << 63;
+
+} // namespace
+
+double EndgameSolver::Shoe::prob(int v) const {
+    if (infinite) return v == 10 ? 4.0 / 13.0 : 1.0 / 13.0;
+    return total ? static_cast<double>(counts[v]) / total : 0.0;
+}
+
+EndgameSolver::Shoe EndgameSolver::Shoe::without(int v) const {
+    if (infinite) return *this;
+    Shoe s = *this;
+    --s.counts[v];
+    if (--s.total == 0) s.infinite = true;   // next draw comes from a fresh shoe
+    return s;
+}
+
+uint64_t EndgameSolver::Shoe::key() const {
+    if (infinite) return kInfiniteKey;
+    uint64_t k = 0;
+    for (int v = 2; v <= 11; ++v) k = (k << 6) | counts[v];
+    return k;
+}
+
+/**
+ * dealerOdds(shoe, raw, aces)
+ * ---------------------------
+ * Distribution of the dealer's final hand, following Dealer::playHand.
+ */
+const EndgameSolver::DealerOdds& EndgameSolver::dealerOdds(const Shoe& s, int raw, int aces) {
+    const int v = Hand::valueOf(raw, aces);
+    const bool soft = Hand::softOf(raw, aces);
+    const Key key{ s.key(), static_cast<uint32_t>(v | (soft ? 64 : 0)) };
+    auto it = dealerMemo.find(key);
+    if (it != dealerMemo.end()) return it->second;
+
+    DealerOdds odds{};
+    const bool draw = (v <= 16) || (v == 17 && soft && hitSoft17);
+    if (!draw) {
+        odds[v > 21 ? 5 : v - 17] = 1.0;
+    }
+    else {
+        for (int c = 2; c <= 11; ++c) {
+            const double p = s.prob(c);
+            if (p == 0.0) continue;
+            const DealerOdds& next = dealerOdds(s.without(c), v + c, (soft ? 1 : 0) + (c == 11 ? 1 : 0));
+            for (size_t i = 0; i < odds.size(); ++i) odds[i] += p * next[i];
+        }
+    }
+    return dealerMemo.emplace(key, odds).first->second;
+}
+
+double EndgameSolver::standEv(const Shoe& s, int playerValue) {
+    const DealerOdds& d = dealerOdds(s, up, up == 11 ? 1 : 0);   // hole card still to come
+    double ev = d[5];
+    for (int total = 17; total <= 21; ++total) {
+        if (playerValue > total) ev += d[total - 17];
+        else if (playerValue < total) ev -= d[total - 17];
+    }
+    return ev;
+}
+
+/**
+ * bestEv(shoe, raw, aces)
+ * -----------------------
+ * max(stand, hit) for a player hand; a bust is -1.
+ */
+double EndgameSolver::bestEv(const Shoe& s, int raw, int aces) {
+    const int v = Hand::valueOf(raw, aces);
+    if (v > 21) return -1.0;
+    const int soft = Hand::softOf(raw, aces) ? 1 : 0;
+
+    const Key key{ s.key(), static_cast<uint32_t>(v | (soft << 6) | (up << 7)) };
+    auto it = playerMemo.find(key);
+    if (it != playerMemo.end()) return it->second;
+
+    const double stand = standEv(s, v);
+    double hit = 0.0;
+    for (int c = 2; c <= 11; ++c) {
+        const double p = s.prob(c);
+        if (p > 0.0) hit += p * bestEv(s.without(c), v + c, soft + (c == 11 ? 1 : 0));
+    }
+    const double best = hit > stand ? hit : stand;
+    playerMemo[key] = best;
+    return best;
+}
+
+/**
+ * solve(unseen, playerHand, dealerUp)
+ * -----------------------------------
+ * The top level is evaluated directly so both EVs can be reported.
+ */
+EndgameResult EndgameSolver::solve(const std::vector<uint8_t>& unseen, const Hand& playerHand, int dealerUp) {
+    EndgameResult r;
+    if (unseen.empty() || playerHand.empty() || dealerUp < 2 || dealerUp > 11) return r;
+
+    Shoe s;
+    for (uint8_t code : unseen) {
+        const int v = card::value(code);
+        if (++s.counts[v] > 63) return r;
+        ++s.total;
+    }
+    const int v = playerHand.value();
+    if (v > 21) return r;
+    const int soft = playerHand.isSoft() ? 1 : 0;
+
+    if (dealerUp != up) {                 // player entries are only valid for one up card
+        playerMemo.clear();
+        up = dealerUp;
+    }
+    r.standEv = standEv(s, v);
+    for (int c = 2; c <= 11; ++c) {
+        const double p = s.prob(c);
+        if (p > 0.0) r.hitEv += p * bestEv(s.without(c), v + c, soft + (c == 11 ? 1 : 0));
+    }
+    r.hit = r.hitEv > r.standEv;
+    r.ev = r.hit ? r.hitEv : r.standEv;
+    r.valid = true;
+    return r;
+}
+
+EndgameResult solveSeat(EndgameSolver& solver, const Table& table, const Player& player) {
+    std::vector<uint8_t> unseen = table.getDeck().shoeCards();
+    const Hand& dealerHand = table.getDealer().getHand();
+    if (dealerHand.size() < 2) return EndgameResult();
+    // only the hole card's value is known to the table; any suit will do
+    const int hole = dealerHand[1];
+    unseen.push_back(card::make(hole == 11 ? card::Ace : (hole == 10 ? card::Ten : hole - 1), card::Spades));
+    return solver.solve(unseen, player.getHand(), dealerHand[0]);
+}
@@ -0,0 +1,83 @@
+#ifndef ENDGAME_H
+#define ENDGAME_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "hand.h"
+
+class Table;
+class Player;
+
+/**
+ * EndgameSolver
+ * - Exact hit/stand EV for one hand given every unseen card: an exhaustive
+ *   search over the draws, with the composition (cards left of each value)
+ *   as part of every memo key, so positions reached by different draw
+ *   orders are solved once (transposition table).
+ * - Hand arithmetic matches the game: Hand::valueOf / softOf for the
+ *   player, Dealer::playHand for the dealer (including the soft-17 rule).
+ * - The player only sees the up card, so the dealer's hole card is still
+ *   "unseen" and belongs in the composition (solveSeat adds it).
+ * - Meant for the end of a shoe: up to 63 cards of any one value. If the
+ *   composition runs dry mid-hand, further draws come from a fresh shoe,
+ *   treated as infinite (1/13 per rank).
+ *
+ * Memo tables persist between solve() calls for the same composition
+ * family; clear() drops them.
+ */
+struct EndgameResult {
+    bool valid = false;     // false: empty/oversized composition or bad hand
+    bool hit = false;       // optimal action
+    double standEv = 0.0;   // units per unit bet
+    double hitEv = 0.0;     // hit, then play on optimally
+    double ev = 0.0;        // max of the two
+};
+
+class EndgameSolver {
+public:
+    explicit EndgameSolver(bool hitSoft17 = false) : hitSoft17(hitSoft17) {}
+
+    // unseen: card codes (Deck::shoeCards() plus the dealer's hole card)
+    EndgameResult solve(const std::vector<uint8_t>& unseen, const Hand& playerHand, int dealerUp);
+    size_t tableSize() const { return playerMemo.size() + dealerMemo.size(); }
+    void clear() { playerMemo.clear(); dealerMemo.clear(); }
+
+private:
+    // counts[v] = unseen cards of blackjack value v (2..11)
+    struct Shoe {
+        std::array<uint8_t, 12> counts{};
+        int total = 0;
+        bool infinite = false;
+
+        double prob(int v) const;
+        Shoe without(int v) const;
+        uint64_t key() const;
+    };
+    struct Key {
+        uint64_t shoe;
+        uint32_t state;
+        bool operator==(const Key& o) const { return shoe == o.shoe && state == o.state; }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& k) const { return std::hash<uint64_t>()(k.shoe * 0x9E3779B97F4A7C15ULL ^ k.state); }
+    };
+    using DealerOdds = std::array<double, 6>;   // final 17..21, bust
+
+    bool hitSoft17;
+    int up = 0;
+    std::unordered_map<Key, double, KeyHash> playerMemo;        // keyed with the up card
+    std::unordered_map<Key, DealerOdds, KeyHash> dealerMemo;
+
+    double standEv(const Shoe& s, int playerValue);
+    double bestEv(const Shoe& s, int raw, int aces);
+    const DealerOdds& dealerOdds(const Shoe& s, int raw, int aces);
+};
+
+// Solver question for a seated player mid-round: unseen = the deck's
+// remaining cards + the dealer's hole card.
+EndgameResult solveSeat(EndgameSolver& solver, const Table& table, const Player& player);
+
+#endif // ENDGAME_H
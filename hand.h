@@ -0,0 +1,75 @@
+#ifndef HAND_H
+#define HAND_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+/**
+ * Hand
+ * - The cards of one blackjack hand, stored inline (fixed capacity, no
+ *   heap), with the running sum and ace count kept as cards arrive so
+ *   value() and isSoft() don't rescan the cards.
+ * - Reads like a small vector<int>: size/empty/front/[]/begin/end.
+ * - Value rule: the raw sum, with aces dropped from 11 to 1 one at a time
+ *   while it is over 21; the hand is soft if an ace still counts as 11.
+ *
+ * kMaxCards covers the longest possible hand (eleven small cards plus
+ * the busting one); cards past it still count toward the value but are
+ * not stored.
+ */
+class Hand {
+public:
+    static constexpr int kMaxCards = 16;
+
+    Hand() = default;
+    Hand(std::initializer_list<int> cards) { for (int c : cards) add(c); }
+
+    void add(int card) {
+        if (count < kMaxCards) cards[count++] = static_cast<uint8_t>(card);
+        raw += card;
+        if (card == 11) ++aces;
+    }
+    void clear() { count = 0; raw = 0; aces = 0; }
+
+    // The value rule on a raw sum and ace count; PlayerStore keeps only
+    // those two per seat and values its hands through these as well.
+    static int valueOf(int raw, int aces) {
+        while (raw > 21 && aces > 0) { raw -= 10; --aces; }
+        return raw;
+    }
+    static bool softOf(int raw, int aces) {   // an ace still counts as 11 after demoting the others
+        while (raw > 21 && aces > 0) { raw -= 10; --aces; }
+        return aces > 0;
+    }
+
+    int value() const { return valueOf(raw, aces); }
+    bool isSoft() const { return softOf(raw, aces); }
+    bool isPair() const { return count == 2 && cards[0] == cards[1]; }
+
+    // Moves the second card of a pair into `other` (which must be empty).
+    void splitInto(Hand& other) {
+        const int moved = cards[1];
+        clear();
+        add(moved);
+        other.clear();
+        other.add(moved);
+    }
+
+    // vector-style read access
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    int front() const { return cards[0]; }
+    int back() const { return cards[count - 1]; }
+    int operator[](size_t i) const { return cards[i]; }
+    const uint8_t* begin() const { return cards; }
+    const uint8_t* end() const { return cards + count; }
+
+private:
+    uint8_t cards[kMaxCards] = {};
+    uint8_t count = 0;
+    uint8_t aces = 0;
+    int16_t raw = 0;
+};
+
+#endif // HAND_H
@@ -0,0 +1,531 @@
+/*
+ * Hand Store Implementation
+ * -------------------------
+ * File layout:
+ *   "CPHS" <version> <3 pad bytes>
+ *   blocks: <u32 rows> then per column:
+ *           <u8 width 0|1|2|4> <3 pad> <i32 base> <u32 payloadBytes>
+ *           <payload: rows * width bytes, padded to 4>
+ *
+ * The writer appends blocks; a query maps the file and walks the blocks,
+ * handing each thread a contiguous range of them.
+ */
+
+#include "handstore.h"
+#include "journal.h"
+#include "person.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <thread>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+static const char kStoreMagic[4] = { 'C', 'P', 'H', 'S' };
+static const uint8_t kStoreVersion = 1;
+static const size_t kHeaderBytes = 8;
+
+static size_t pad4(size_t n) { return (n + 3) & ~static_cast<size_t>(3); }
+
+// ====================================================
+// Writer
+// ====================================================
+
+HandStoreWriter::~HandStoreWriter() {
+    close();
+}
+
+/**
+ * open(path)
+ * ----------
+ * Opens for appending; writes the header when the file is new.
+ */
+bool HandStoreWriter::open(const string& path) {
+    close();
+    writeFailed = false;
+    file = fopen(path.c_str(), "ab");
+    if (!file) return false;
+    fseek(file, 0, SEEK_END);
+    if (ftell(file) == 0) {
+        const uint8_t header[kHeaderBytes] = { 'C', 'P', 'H', 'S', kStoreVersion, 0, 0, 0 };
+        put(header, sizeof(header));
+    }
+    for (auto& c : cols) c.reserve(kBlockRows);
+    return !writeFailed;
+}
+
+//writes and latches a short write (disk full, I/O error) into writeFailed
+void HandStoreWriter::put(const void* data, size_t bytes) {
+    if (bytes && fwrite(data, 1, bytes, file) != bytes) writeFailed = true;
+}
+
+void HandStoreWriter::append(const HandRow& row) {
+    cols[ColPlayerTotal].push_back(row.playerTotal);
+    cols[ColDealerUp].push_back(row.dealerUp);
+    cols[ColAction].push_back(row.action);
+    cols[ColOutcome].push_back(row.outcome);
+    cols[ColBet].push_back(row.bet);
+    cols[ColNet].push_back(row.net);
+    ++rows;
+    if (cols[0].size() >= kBlockRows) flushBlock();
+}
+
+/**
+ * flushBlock()
+ * ------------
+ * Frame-of-reference encodes each column: base = column minimum, then
+ * the narrowest width that holds (max - min).
+ */
+void HandStoreWriter::flushBlock() {
+    const uint32_t n = static_cast<uint32_t>(cols[0].size());
+    if (!file || n == 0) return;
+    put(&n, sizeof(n));
+
+    vector<uint8_t> payload;
+    for (int c = 0; c < ColCount; ++c) {
+        const vector<int32_t>& v = cols[c];
+        const auto mm = minmax_element(v.begin(), v.end());
+        const int32_t base = *mm.first;
+        const uint32_t range = static_cast<uint32_t>(static_cast<int64_t>(*mm.second) - base);
+        const uint8_t width = range == 0 ? 0 : range <= 0xFF ? 1 : range <= 0xFFFF ? 2 : 4;
+
+        payload.assign(pad4(static_cast<size_t>(n) * width), 0);
+        for (uint32_t i = 0; i < n && width; ++i) {
+            const uint32_t d = static_cast<uint32_t>(static_cast<int64_t>(v[i]) - base);
+            memcpy(&payload[static_cast<size_t>(i) * width], &d, width);   // little-endian low bytes
+        }
+
+        const uint8_t desc[4] = { width, 0, 0, 0 };
+        const uint32_t bytes = static_cast<uint32_t>(payload.size());
+        put(desc, sizeof(desc));
+        put(&base, sizeof(base));
+        put(&bytes, sizeof(bytes));
+        put(payload.data(), bytes);
+    }
+    for (auto& c : cols) c.clear();
+}
+
+bool HandStoreWriter::close() {
+    if (!file) return !writeFailed;
+    flushBlock();
+    if (fclose(file) != 0) writeFailed = true;   // the buffered tail can fail here too
+    file = nullptr;
+    return !writeFailed;
+}
+
+// ====================================================
+// Memory-mapped reader
+// ====================================================
+
+namespace {
+
+class MappedFile {
+public:
+    ~MappedFile() { unmap(); }
+
+    bool map(const string& path) {
+#ifdef _WIN32
+        fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER sz;
+        if (!GetFileSizeEx(fileHandle, &sz) || sz.QuadPart == 0) return false;
+        len = static_cast<size_t>(sz.QuadPart);
+        mapping = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) return false;
+        base = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        return base != nullptr;
+#else
+        fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) return false;
+        len = static_cast<size_t>(st.st_size);
+        void* p = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) return false;
+        madvise(p, len, MADV_SEQUENTIAL);
+        base = static_cast<const uint8_t*>(p);
+        return true;
+#endif
+    }
+
+    void unmap() {
+#ifdef _WIN32
+        if (base) UnmapViewOfFile(base);
+        if (mapping) CloseHandle(mapping);
+        if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+        mapping = nullptr;
+        fileHandle = INVALID_HANDLE_VALUE;
+#else
+        if (base) munmap(const_cast<uint8_t*>(base), len);
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+#endif
+        base = nullptr;
+        len = 0;
+    }
+
+    const uint8_t* data() const { return base; }
+    size_t size() const { return len; }
+
+private:
+    const uint8_t* base = nullptr;
+    size_t len = 0;
+#ifdef _WIN32
+    HANDLE fileHandle = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+};
+
+struct ColumnView {
+    uint8_t width = 0;
+    int32_t base = 0;
+    const uint8_t* payload = nullptr;
+};
+
+struct BlockView {
+    uint32_t rows = 0;
+    ColumnView cols[ColCount];
+};
+
+// Reads value i of a column stored with width W (memcpy = unaligned-safe load).
+template <int W>
+inline uint32_t loadAt(const uint8_t* p, size_t i) {
+    if (W == 1) return p[i];
+    if (W == 2) { uint16_t v; memcpy(&v, p + i * 2, 2); return v; }
+    uint32_t v; memcpy(&v, p + i * 4, 4); return v;
+}
+
+// sel[i] &= (col[i] == target)
+template <int W>
+static void filterEq(const uint8_t* p, uint32_t n, uint32_t target, uint8_t* sel) {
+    for (uint32_t i = 0; i < n; ++i) sel[i] &= static_cast<uint8_t>(loadAt<W>(p, i) == target);
+}
+
+// Returns false if no row of the block can match (skip the block).
+static bool applyFilter(const ColumnView& c, int want, uint32_t n, uint8_t* sel) {
+    if (want < 0) return true;
+    const int64_t d = static_cast<int64_t>(want) - c.base;
+    if (c.width == 0) return d == 0;                    // constant column
+    if (d < 0 || d > (c.width == 1 ? 0xFF : c.width == 2 ? 0xFFFF : 0xFFFFFFFFLL)) return false;
+    const uint32_t t = static_cast<uint32_t>(d);
+    if (c.width == 1) filterEq<1>(c.payload, n, t, sel);
+    else if (c.width == 2) filterEq<2>(c.payload, n, t, sel);
+    else filterEq<4>(c.payload, n, t, sel);
+    return true;
+}
+
+// Sum of (col[i] - base) over selected rows.
+template <int W>
+static uint64_t sumSelected(const uint8_t* p, uint32_t n, const uint8_t* sel) {
+    uint64_t s = 0;
+    for (uint32_t i = 0; i < n; ++i) s += static_cast<uint64_t>(sel[i]) * loadAt<W>(p, i);
+    return s;
+}
+
+static int64_t sumColumn(const ColumnView& c, uint32_t n, const uint8_t* sel, uint64_t matched) {
+    uint64_t s = 0;
+    if (c.width == 1) s = sumSelected<1>(c.payload, n, sel);
+    else if (c.width == 2) s = sumSelected<2>(c.payload, n, sel);
+    else if (c.width == 4) s = sumSelected<4>(c.payload, n, sel);
+    return static_cast<int64_t>(s) + static_cast<int64_t>(c.base) * static_cast<int64_t>(matched);
+}
+
+template <int W>
+static uint64_t countEq(const uint8_t* p, uint32_t n, uint32_t target, const uint8_t* sel) {
+    uint64_t k = 0;
+    for (uint32_t i = 0; i < n; ++i) k += sel[i] & static_cast<uint8_t>(loadAt<W>(p, i) == target);
+    return k;
+}
+
+static uint64_t countOutcome(const ColumnView& c, int outcome, uint32_t n, const uint8_t* sel, uint64_t matched) {
+    const int64_t d = static_cast<int64_t>(outcome) - c.base;
+    if (c.width == 0) return d == 0 ? matched : 0;
+    if (d < 0 || d > 0xFF) return 0;   // outcomes are 0..2, always 1 byte wide
+    const uint32_t t = static_cast<uint32_t>(d);
+    if (c.width == 1) return countEq<1>(c.payload, n, t, sel);
+    if (c.width == 2) return countEq<2>(c.payload, n, t, sel);
+    return countEq<4>(c.payload, n, t, sel);
+}
+
+// Splits the mapped file into block views; false if the file is damaged.
+static bool indexBlocks(const uint8_t* data, size_t len, vector<BlockView>& blocks, string& err) {
+    if (len < kHeaderBytes || memcmp(data, kStoreMagic, 4) != 0 || data[4] != kStoreVersion) {
+        err = "not a hand store";
+        return false;
+    }
+    size_t pos = kHeaderBytes;
+    while (pos < len) {
+        BlockView b;
+        if (pos + 4 > len) { err = "truncated block"; return false; }
+        memcpy(&b.rows, data + pos, 4);
+        pos += 4;
+        for (int c = 0; c < ColCount; ++c) {
+            if (pos + 12 > len) { err = "truncated block"; return false; }
+            uint32_t bytes;
+            b.cols[c].width = data[pos];
+            memcpy(&b.cols[c].base, data + pos + 4, 4);
+            memcpy(&bytes, data + pos + 8, 4);
+            pos += 12;
+            const uint8_t w = b.cols[c].width;
+            if (w != 0 && w != 1 && w != 2 && w != 4) {   // the scans only read these widths
+                err = "corrupt block";
+                return false;
+            }
+            if (pos + bytes > len || bytes < static_cast<size_t>(b.rows) * b.cols[c].width) {
+                err = "truncated block";
+                return false;
+            }
+            b.cols[c].payload = data + pos;
+            pos += bytes;
+        }
+        blocks.push_back(b);
+    }
+    return true;
+}
+
+static void scanBlocks(const BlockView* begin, const BlockView* end, const HandQuery& q, HandQueryResult& r) {
+    vector<uint8_t> sel(HandStoreWriter::kBlockRows);
+    for (const BlockView* b = begin; b != end; ++b) {
+        const uint32_t n = b->rows;
+        r.rows += n;
+        if (n > sel.size()) sel.resize(n);
+        fill(sel.begin(), sel.begin() + n, static_cast<uint8_t>(1));
+
+        if (!applyFilter(b->cols[ColPlayerTotal], q.playerTotal, n, sel.data())) continue;
+        if (!applyFilter(b->cols[ColDealerUp], q.dealerUp, n, sel.data())) continue;
+        if (!applyFilter(b->cols[ColAction], q.action, n, sel.data())) continue;
+
+        uint64_t matched = 0;
+        for (uint32_t i = 0; i < n; ++i) matched += sel[i];
+        if (matched == 0) continue;
+
+        r.matched += matched;
+        r.wins += countOutcome(b->cols[ColOutcome], HandJournal::OutcomeWin, n, sel.data(), matched);
+        r.losses += countOutcome(b->cols[ColOutcome], HandJournal::OutcomeLoss, n, sel.data(), matched);
+        r.pushes += countOutcome(b->cols[ColOutcome], HandJournal::OutcomePush, n, sel.data(), matched);
+        r.totalBet += sumColumn(b->cols[ColBet], n, sel.data(), matched);
+        r.totalNet += sumColumn(b->cols[ColNet], n, sel.data(), matched);
+    }
+}
+
+} // namespace
+
+/**
+ * runHandQuery(path, q, out)
+ * --------------------------
+ * Maps the store, indexes its blocks, then scans contiguous block ranges
+ * on q.threads threads and adds the partial results together.
+ */
+bool runHandQuery(const string& path, const HandQuery& q, HandQueryResult& out) {
+    out = HandQueryResult();
+    MappedFile mf;
+    if (!mf.map(path)) { out.error = "cannot map " + path; return false; }
+
+    vector<BlockView> blocks;
+    if (!indexBlocks(mf.data(), mf.size(), blocks, out.error)) return false;
+    if (blocks.empty()) return true;
+
+    size_t threads = q.threads > 0 ? static_cast<size_t>(q.threads) : thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    threads = min(threads, blocks.size());
+
+    vector<HandQueryResult> partial(threads);
+    vector<thread> workers;
+    const size_t per = (blocks.size() + threads - 1) / threads;
+    for (size_t t = 0; t < threads; ++t) {
+        const size_t lo = t * per;
+        const size_t hi = min(blocks.size(), lo + per);
+        if (lo >= hi) break;
+        workers.emplace_back(scanBlocks, blocks.data() + lo, blocks.data() + hi, cref(q), ref(partial[t]));
+    }
+    for (auto& w : workers) w.join();
+
+    for (const auto& p : partial) {
+        out.rows += p.rows;
+        out.matched += p.matched;
+        out.wins += p.wins;
+        out.losses += p.losses;
+        out.pushes += p.pushes;
+        out.totalBet += p.totalBet;
+        out.totalNet += p.totalNet;
+    }
+    return true;
+}
+
+// ====================================================
+// Journal conversion
+// ====================================================
+
+/**
+ * convertJournal(journalPath, storePath)
+ * --------------------------------------
+ * Replays the journal and appends one row per SETTLE record: the seat's
+ * first two cards, the dealer's first card, the seat's first decision,
+ * then outcome, net and the stake of the hand being settled (the bet,
+ * doubled if that hand was doubled; split hands start at the bet of the
+ * hand they came from).
+ */
+long long convertJournal(const string& journalPath, const string& storePath) {
+    JournalReader in;
+    if (!in.open(journalPath)) return -1;
+    HandStoreWriter out;
+    if (!out.open(storePath)) return -1;
+
+    struct SeatRound {
+        Person firstTwo;
+        int cards = 0;
+        int action = -1;
+        int pending = -1;               // double / split waiting for its CARD
+        int bet = 0;
+        vector<int> stakes;             // per hand
+        size_t settled = 0;
+    };
+    map<uint32_t, SeatRound> seats;
+    int dealerUp = 0;
+    long long written = 0;
+
+    JournalEvent ev;
+    while (in.next(ev)) {
+        switch (ev.tag) {
+        case HandJournal::TagRound:
+            seats.clear();
+            dealerUp = 0;
+            break;
+        case HandJournal::TagBet:
+            seats[ev.seat].bet = static_cast<int>(ev.a);
+            break;
+        case HandJournal::TagCard:
+            if (ev.seat == HandJournal::kDealerSeat) {
+                if (dealerUp == 0) dealerUp = static_cast<int>(ev.a);
+            }
+            else {
+                SeatRound& s = seats[ev.seat];
+                if (s.cards++ < 2) s.firstTwo.cardDealt(static_cast<int>(ev.a));
+                if (s.stakes.empty()) s.stakes.push_back(s.bet);
+                const size_t hand = static_cast<size_t>(ev.b);
+                if (hand < s.stakes.size()) {
+                    if (s.pending == HandJournal::ActionDouble) s.stakes[hand] *= 2;
+                    else if (s.pending == HandJournal::ActionSplit) s.stakes.push_back(s.stakes[hand]);
+                }
+                s.pending = -1;
+            }
+            break;
+        case HandJournal::TagAction: {
+            SeatRound& s = seats[ev.seat];
+            if (s.action < 0) s.action = static_cast<int>(ev.a);
+            s.pending = static_cast<int>(ev.a);
+            break;
+        }
+        case HandJournal::TagSettle: {
+            SeatRound& s = seats[ev.seat];
+            if (s.cards < 2) break;   // seat sat the round out
+            const size_t hand = s.settled++;
+            HandRow row;
+            row.playerTotal = s.firstTwo.handValue();
+            row.dealerUp = dealerUp;
+            row.action = s.action < 0 ? 0 : s.action;
+            row.outcome = static_cast<int32_t>(ev.a);
+            row.bet = hand < s.stakes.size() ? s.stakes[hand] : s.bet;
+            row.net = static_cast<int32_t>(ev.b);
+            out.append(row);
+            ++written;
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    if (!out.close()) return -1;
+    return in.error().empty() ? written : -1;
+}
+
+// ====================================================
+// Command-line tool
+// ====================================================
+
+// whole-string integer, false on anything else
+static bool parseInt(const string& text, int& value) {
+    size_t used = 0;
+    try {
+        value = stoi(text, &used);
+    }
+    catch (...) {
+        return false;
+    }
+    return used == text.size();
+}
+
+static bool parseAction(const string& text, int& action) {
+    if (text == "stand") action = HandJournal::ActionStand;
+    else if (text == "hit") action = HandJournal::ActionHit;
+    else if (text == "double") action = HandJournal::ActionDouble;
+    else if (text == "split") action = HandJournal::ActionSplit;
+    else return false;
+    return true;
+}
+
+static int usage() {
+    cout << "usage: convert <journal> <store>\n"
+        << "       query <store> [total=N] [up=N] [action=hit|stand|double|split] [threads=N]\n";
+    return 1;
+}
+
+/**
+ * runHandStoreTool(argc, argv)
+ * ----------------------------
+ * argv[1] is "convert" or "query" (see handstore.h). Prints results and
+ * returns a process exit code.
+ */
+int runHandStoreTool(int argc, char* argv[]) {
+    const string cmd = argc > 1 ? argv[1] : "";
+    if (cmd == "convert" && argc == 4) {
+        const long long n = convertJournal(argv[2], argv[3]);
+        if (n < 0) { cout << "convert failed\n"; return 1; }
+        cout << "rows written: " << n << "\n";
+        return 0;
+    }
+    if (cmd == "query" && argc >= 3) {
+        HandQuery q;
+        for (int i = 3; i < argc; ++i) {
+            const string arg = argv[i];
+            const size_t eq = arg.find('=');
+            const string key = arg.substr(0, eq);
+            const string val = eq == string::npos ? "" : arg.substr(eq + 1);
+            bool ok = false;
+            if (key == "total") ok = parseInt(val, q.playerTotal) && q.playerTotal >= 0;
+            else if (key == "up") ok = parseInt(val, q.dealerUp) && q.dealerUp >= 0;
+            else if (key == "action") ok = parseAction(val, q.action);
+            else if (key == "threads") ok = parseInt(val, q.threads) && q.threads >= 0;
+            if (!ok) {
+                cout << "bad filter: " << arg << "\n";
+                return usage();
+            }
+        }
+        HandQueryResult r;
+        if (!runHandQuery(argv[2], q, r)) { cout << "query failed: " << r.error << "\n"; return 1; }
+        const double hands = r.matched ? static_cast<double>(r.matched) : 1.0;
+        cout << "rows scanned: " << r.rows << "\n"
+            << "matched:      " << r.matched << "\n"
+            << "win/loss/push: " << r.wins << "/" << r.losses << "/" << r.pushes << "\n"
+            << "win rate:     " << (r.wins / hands) << "\n"
+            << "total bet:    " << r.totalBet << "\n"
+            << "total net:    " << r.totalNet << "\n"
+            << "net per hand: " << (r.totalNet / hands) << "\n";
+        return 0;
+    }
+    return usage();
+}
@@ -0,0 +1,90 @@
+#ifndef HANDSTORE_H
+#define HANDSTORE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * Hand store (columnar hand history)
+ * - One row per settled hand: player's two-card total, dealer up card,
+ *   first decision, outcome, bet and net result.
+ * - Rows are stored in blocks of up to 64K; inside a block every column is
+ *   stored separately and frame-of-reference compressed: the block keeps
+ *   the column's minimum and each row stores (value - min) in 0, 1, 2 or 4
+ *   bytes. Most columns end up at 1 byte/row (or 0 if constant).
+ * - Queries mmap the file and scan each column as a flat array, so the
+ *   filter/aggregate loops are simple enough for the compiler to vectorize;
+ *   blocks are split across threads.
+ *
+ * Rows are normally produced from the binary journal (convertJournal).
+ */
+struct HandRow {
+    int32_t playerTotal = 0;  // first two cards
+    int32_t dealerUp = 0;     // 2..11
+    int32_t action = 0;       // first decision: HandJournal::Action (0 stand, 1 hit, 2 double, 3 split)
+    int32_t outcome = 0;      // HandJournal::Outcome (0 loss, 1 win, 2 push)
+    int32_t bet = 0;
+    int32_t net = 0;          // money delta at settlement
+};
+
+enum HandColumn {
+    ColPlayerTotal = 0, ColDealerUp, ColAction, ColOutcome, ColBet, ColNet, ColCount
+};
+
+class HandStoreWriter {
+public:
+    static constexpr uint32_t kBlockRows = 65536;
+
+    HandStoreWriter() = default;
+    ~HandStoreWriter();
+    HandStoreWriter(const HandStoreWriter&) = delete;
+    HandStoreWriter& operator=(const HandStoreWriter&) = delete;
+
+    bool open(const std::string& path);   // appends if the file exists
+    void append(const HandRow& row);
+    bool close();                         // flushes the partial block; false if any write failed
+
+    uint64_t rowsWritten() const { return rows; }
+    bool failed() const { return writeFailed; }
+
+private:
+    FILE* file = nullptr;
+    std::vector<int32_t> cols[ColCount];
+    uint64_t rows = 0;
+    bool writeFailed = false;             // latched by the first short write
+
+    void put(const void* data, size_t bytes);
+    void flushBlock();
+};
+
+// Equality filters (-1 = any) and the aggregates every query returns.
+struct HandQuery {
+    int playerTotal = -1;
+    int dealerUp = -1;
+    int action = -1;
+    int threads = 0;          // 0 = hardware concurrency
+};
+
+struct HandQueryResult {
+    uint64_t rows = 0;        // rows scanned
+    uint64_t matched = 0;
+    uint64_t wins = 0;
+    uint64_t losses = 0;
+    uint64_t pushes = 0;
+    int64_t totalBet = 0;
+    int64_t totalNet = 0;
+    std::string error;        // empty on success
+};
+
+bool runHandQuery(const std::string& path, const HandQuery& q, HandQueryResult& out);
+
+// Journal -> hand store conversion; returns the number of rows written (-1 on error).
+long long convertJournal(const std::string& journalPath, const std::string& storePath);
+
+// Command-line front end: "convert <journal> <store>" or
+// "query <store> [total=N] [up=N] [action=hit|stand|double|split]".
+int runHandStoreTool(int argc, char* argv[]);
+
+#endif // HANDSTORE_H
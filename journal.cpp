@@ -0,0 +1,407 @@
+/*
+ * HandJournal Implementation
+ * --------------------------
+ * Encodes round events into an in-memory buffer and group-commits the
+ * buffer to disk. replayJournal() decodes a file and rebuilds the seats
+ * by feeding the same events back through Player.
+ */
+
+#include "journal.h"
+#include "card.h"
+#include <cstring>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+static const char kMagic[4] = { 'C', 'P', 'H', 'J' };
+
+HandJournal::~HandJournal() {
+    close();
+}
+
+/**
+ * open(path, groupRounds, groupBytes)
+ * -----------------------------------
+ * Opens the file for appending (writing the header if it is new) and
+ * starts a new session. Returns false if the file can't be opened or is
+ * a journal of another version (or not a journal at all).
+ */
+bool HandJournal::open(const std::string& path, int inGroupRounds, size_t inGroupBytes) {
+    close();
+    if (FILE* existing = std::fopen(path.c_str(), "rb")) {
+        // never append records of this version under another version's header
+        uint8_t header[5];
+        const size_t n = std::fread(header, 1, sizeof(header), existing);
+        std::fclose(existing);
+        if (n > 0 && (n < sizeof(header) || std::memcmp(header, kMagic, 4) != 0 || header[4] != kVersion))
+            return false;
+    }
+    file = std::fopen(path.c_str(), "ab");
+    if (!file) return false;
+    writeFailed = false;
+    groupRounds = inGroupRounds < 1 ? 1 : inGroupRounds;
+    groupBytes = inGroupBytes;
+    buf.reserve(groupBytes + 1024);
+
+    std::fseek(file, 0, SEEK_END);
+    if (std::ftell(file) == 0) {
+        buf.insert(buf.end(), kMagic, kMagic + 4);
+        buf.push_back(kVersion);
+    }
+    putTag(TagSession);
+    seats.clear();
+    roundNo = 0;
+    return true;
+}
+
+/**
+ * close()
+ * -------
+ * Commits anything still buffered and closes the file. Returns false if
+ * this or any earlier commit failed.
+ */
+bool HandJournal::close() {
+    if (!file) return !writeFailed;
+    commit();
+    if (std::fclose(file) != 0) writeFailed = true;
+    file = nullptr;
+    return !writeFailed;
+}
+
+void HandJournal::putVarint(uint64_t v) {
+    while (v >= 0x80) {
+        buf.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    buf.push_back(static_cast<uint8_t>(v));
+}
+
+// zigzag so small negative numbers stay small
+void HandJournal::putSigned(int64_t v) {
+    putVarint((static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63));
+}
+
+/**
+ * seatOf(p)
+ * ---------
+ * Seat id for a player, emitting a SEAT record the first time the
+ * player shows up in this session.
+ */
+uint32_t HandJournal::seatOf(const Player& p) {
+    auto it = seats.find(&p);
+    if (it != seats.end()) return it->second;
+    const uint32_t id = static_cast<uint32_t>(seats.size()) + 1;   // 0 is the dealer
+    seats.emplace(&p, id);
+    putTag(TagSeat);
+    putVarint(id);
+    putSigned(p.getStartingMoney());
+    putVarint(p.getName().size());
+    buf.insert(buf.end(), p.getName().begin(), p.getName().end());
+    return id;
+}
+
+void HandJournal::beginRound(unsigned int deckSeed, int shoeIndex, size_t shoePosition) {
+    putTag(TagRound);
+    putVarint(++roundNo);
+    putVarint(deckSeed);
+    putVarint(static_cast<uint64_t>(shoeIndex));
+    putVarint(shoePosition);
+}
+
+void HandJournal::bet(const Player& p, int amount) {
+    const uint32_t seat = seatOf(p);
+    putTag(TagBet);
+    putVarint(seat);
+    putSigned(amount);
+}
+
+void HandJournal::card(const Player& p, int hand, uint8_t code) {
+    const uint32_t seat = seatOf(p);
+    putTag(TagCard);
+    putVarint(seat);
+    putVarint(static_cast<uint64_t>(hand));
+    buf.push_back(code);
+}
+
+void HandJournal::dealerCard(uint8_t code) {
+    putTag(TagCard);
+    putVarint(kDealerSeat);
+    putVarint(0);
+    buf.push_back(code);
+}
+
+void HandJournal::action(const Player& p, Action a) {
+    const uint32_t seat = seatOf(p);
+    putTag(TagAction);
+    putVarint(seat);
+    buf.push_back(static_cast<uint8_t>(a));
+}
+
+void HandJournal::settle(const Player& p, Outcome outcome, int delta) {
+    const uint32_t seat = seatOf(p);
+    putTag(TagSettle);
+    putVarint(seat);
+    buf.push_back(outcome);
+    putSigned(delta);
+}
+
+/**
+ * endRound()
+ * ----------
+ * Marks the round complete and commits once enough rounds (or bytes)
+ * have piled up.
+ */
+void HandJournal::endRound() {
+    putTag(TagEnd);
+    if (++roundsPending >= groupRounds || buf.size() >= groupBytes) commit();
+}
+
+/**
+ * commit()
+ * --------
+ * One write and one fsync for every round buffered since the last commit.
+ * After a failure the buffer is dropped rather than retried (a partial
+ * write can't be redone without duplicating records).
+ */
+bool HandJournal::commit() {
+    if (!file || buf.empty()) return !writeFailed;
+    if (!writeFailed) {
+        bool ok = std::fwrite(buf.data(), 1, buf.size(), file) == buf.size();
+        ok = std::fflush(file) == 0 && ok;
+#ifdef _WIN32
+        ok = ok && _commit(_fileno(file)) == 0;
+#else
+        ok = ok && fsync(fileno(file)) == 0;
+#endif
+        if (ok) ++syncs;
+        else writeFailed = true;
+    }
+    buf.clear();
+    roundsPending = 0;
+    return !writeFailed;
+}
+
+// ====================================================
+// Reader
+// ====================================================
+
+/**
+ * JournalReader::open(path)
+ * -------------------------
+ * Loads the file and checks the header. Returns false with error() set
+ * if the file is missing or isn't a journal this build understands.
+ */
+bool JournalReader::open(const std::string& path) {
+    data.clear();
+    pos = 0;
+    err.clear();
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) { err = "cannot open " + path; return false; }
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), f)) > 0) data.insert(data.end(), chunk, chunk + n);
+    std::fclose(f);
+
+    if (data.size() < 5 || std::memcmp(data.data(), kMagic, 4) != 0) {
+        err = "not a hand journal";
+        return false;
+    }
+    version = data[4];
+    if (version < 1 || version > HandJournal::kVersion) {
+        err = "unsupported journal version";
+        return false;
+    }
+    pos = 5;
+    return true;
+}
+
+uint8_t JournalReader::byte(bool& bad) {
+    if (pos >= data.size()) { bad = true; return 0; }
+    return data[pos++];
+}
+
+uint64_t JournalReader::varint(bool& bad) {
+    uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        const uint8_t b = byte(bad);
+        v |= static_cast<uint64_t>(b & 0x7F) << shift;
+        if (!(b & 0x80)) return v;
+    }
+    bad = true;
+    return v;
+}
+
+int64_t JournalReader::signedVarint(bool& bad) {
+    const uint64_t z = varint(bad);
+    return static_cast<int64_t>(z >> 1) ^ -static_cast<int64_t>(z & 1);
+}
+
+/**
+ * next(ev)
+ * --------
+ * Decodes the next record. Returns false at the end of the file, on a
+ * torn final record (the process died mid-write; treated as the end), or
+ * on an unknown tag (error() is set).
+ */
+bool JournalReader::next(JournalEvent& ev) {
+    if (pos >= data.size()) return false;
+    const size_t recordStart = pos;
+    bool bad = false;
+    ev = JournalEvent();
+    ev.tag = byte(bad);
+    switch (ev.tag) {
+    case HandJournal::TagSession:
+    case HandJournal::TagEnd:
+        break;
+    case HandJournal::TagSeat: {
+        ev.seat = static_cast<uint32_t>(varint(bad));
+        ev.a = signedVarint(bad);
+        const uint64_t len = varint(bad);
+        if (bad || pos + len > data.size()) { bad = true; break; }
+        ev.name.assign(reinterpret_cast<const char*>(&data[pos]), static_cast<size_t>(len));
+        pos += static_cast<size_t>(len);
+        break;
+    }
+    case HandJournal::TagRound:
+        ev.a = static_cast<int64_t>(varint(bad));
+        ev.b = static_cast<int64_t>(varint(bad));
+        ev.c = static_cast<int64_t>(varint(bad));
+        ev.d = static_cast<int64_t>(varint(bad));
+        break;
+    case HandJournal::TagBet:
+        ev.seat = static_cast<uint32_t>(varint(bad));
+        ev.a = signedVarint(bad);
+        break;
+    case HandJournal::TagCard:
+        ev.seat = static_cast<uint32_t>(varint(bad));
+        if (version >= 2) ev.b = static_cast<int64_t>(varint(bad));
+        ev.a = byte(bad);
+        ev.c = -1;
+        if (version >= 3) {
+            ev.c = ev.a;
+            ev.a = card::value(static_cast<uint8_t>(ev.c));
+        }
+        break;
+    case HandJournal::TagAction:
+        ev.seat = static_cast<uint32_t>(varint(bad));
+        ev.a = byte(bad);
+        break;
+    case HandJournal::TagSettle:
+        ev.seat = static_cast<uint32_t>(varint(bad));
+        ev.a = byte(bad);
+        ev.b = signedVarint(bad);
+        break;
+    default:
+        err = "unknown record tag";
+        pos = data.size();
+        return false;
+    }
+    if (bad) {
+        pos = recordStart;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * replayJournal(path, out)
+ * ------------------------
+ * Replays every record through Player. A double or split is applied when
+ * its first CARD names the hand, then SETTLE records settle the seat's
+ * hands in order with the recorded delta, which is compared with
+ * result * stake. Returns false with out.error set if the file is
+ * missing or malformed (mismatches alone don't fail the replay).
+ */
+bool replayJournal(const std::string& path, JournalReplay& out) {
+    out = JournalReplay();
+    JournalReader in;
+    if (!in.open(path)) { out.error = in.error(); return false; }
+
+    auto seatPlayer = [&](uint32_t seat) -> Player* {
+        if (seat == 0 || seat > out.players.size()) return nullptr;
+        return &out.players[seat - 1];
+    };
+
+    // per seat: the action waiting for its card, and the next hand to settle
+    std::map<uint32_t, int> pending, settled;
+    int64_t roundNo = 0;
+
+    JournalEvent ev;
+    while (in.next(ev)) {
+        switch (ev.tag) {
+        case HandJournal::TagSession:
+            out = JournalReplay();
+            break;
+        case HandJournal::TagSeat:
+            out.players.emplace_back(ev.name, static_cast<int>(ev.a));
+            break;
+        case HandJournal::TagRound:
+            roundNo = ev.a;
+            out.deckSeed = static_cast<unsigned int>(ev.b);
+            out.shoeIndex = static_cast<int>(ev.c);
+            out.shoePosition = static_cast<size_t>(ev.d);
+            for (Player& p : out.players) p.clearHand();
+            out.dealerHand.clear();
+            out.dealerCodes.clear();
+            out.seatCodes.clear();
+            pending.clear();
+            settled.clear();
+            break;
+        case HandJournal::TagBet:
+            if (Player* p = seatPlayer(ev.seat)) p->setBet(static_cast<int>(ev.a));
+            break;
+        case HandJournal::TagCard: {
+            if (ev.seat == HandJournal::kDealerSeat) {
+                out.dealerHand.push_back(static_cast<int>(ev.a));
+                if (ev.c >= 0) out.dealerCodes.push_back(static_cast<uint8_t>(ev.c));
+                break;
+            }
+            Player* p = seatPlayer(ev.seat);
+            if (!p) break;
+            if (ev.c >= 0) {
+                if (out.seatCodes.size() < out.players.size()) out.seatCodes.resize(out.players.size());   // seats join mid-round
+                out.seatCodes[ev.seat - 1].push_back(static_cast<uint8_t>(ev.c));
+            }
+            int hand = static_cast<int>(ev.b);
+            int& action = pending[ev.seat];
+            if (action == HandJournal::ActionSplit && hand < p->handCount()) {
+                const bool aces = p->handAt(hand).front() == 11;
+                const int other = p->splitHand(hand);
+                if (aces && other >= 0) { p->lockHand(hand); p->lockHand(other); }
+            }
+            else if (action == HandJournal::ActionDouble && hand < p->handCount()) p->doubleHand(hand);
+            action = -1;
+            if (hand < 0 || hand >= p->handCount()) hand = 0;   // not a hand this replay knows
+            p->dealToHand(hand, static_cast<int>(ev.a));
+            break;
+        }
+        case HandJournal::TagAction:
+            if (seatPlayer(ev.seat)) pending[ev.seat] = static_cast<int>(ev.a);
+            break;
+        case HandJournal::TagSettle: {
+            Player* p = seatPlayer(ev.seat);
+            if (!p) break;
+            const int hand = settled[ev.seat]++;
+            const int result = ev.a == HandJournal::OutcomeWin ? 1 : (ev.a == HandJournal::OutcomeLoss ? -1 : 0);
+            if (hand >= p->handCount()) break;
+            const int paid = static_cast<int>(ev.b);
+            const int expected = result * p->betOn(hand);
+            if (paid != expected) {
+                out.mismatches.push_back("round " + std::to_string(roundNo) + " seat " + std::to_string(ev.seat)
+                    + " hand " + std::to_string(hand) + ": paid " + std::to_string(paid)
+                    + ", expected " + std::to_string(expected));
+            }
+            p->settleHandFor(hand, result, paid);
+            break;
+        }
+        case HandJournal::TagEnd:
+            for (Player& p : out.players) p.clearHand();   // as the table does after settling
+            ++out.rounds;
+            break;
+        }
+    }
+    if (!in.error().empty()) { out.error = in.error(); return false; }
+    return true;
+}
@@ -0,0 +1,165 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+#include "player.h"
+
+/**
+ * HandJournal
+ * - Append-only binary hand history: every round's shoe seed/position,
+ *   bets, cards to each seat and the dealer, hit/stand/double/split
+ *   decisions and settlements.
+ * - Records are a one-byte tag followed by varints, so a typical round is
+ *   a few dozen bytes.
+ * - Group commit: records collect in memory and are written + fsync'ed
+ *   once every `groupRounds` rounds (or `groupBytes` bytes), so the sync
+ *   cost is shared by many rounds. Closing the journal always commits.
+ * - A failed write, flush or sync latches failed(): the records of that
+ *   commit are lost (the file may end mid-record, which the reader treats
+ *   as a truncated tail) and nothing more is written until reopened.
+ *
+ * File layout:
+ *   "CPHJ" <version byte>, then records:
+ *   SESSION                              new session, seat ids restart
+ *   SEAT    <seat> <startMoney> <len> <name bytes>
+ *   ROUND   <round> <deckSeed> <shoeIndex> <shoePosition>
+ *   BET     <seat> <amount>
+ *   CARD    <seat> <hand> <card code>    seat 0 = dealer (hand 0); a split's
+ *                                        new hand is the next free index;
+ *                                        rank + suit byte (card.h)
+ *   ACTION  <seat> <0 stand | 1 hit | 2 double | 3 split>
+ *                                        a hit/double is followed by its CARD,
+ *                                        a split by one CARD per hand (the
+ *                                        split hand's first); that CARD's
+ *                                        hand is the one acted on
+ *   SETTLE  <seat> <0 loss | 1 win | 2 push> <money delta>
+ *                                        one per hand, in hand order
+ *   END                                  round complete
+ * Older files are still read: version 2 CARDs hold the blackjack value
+ * instead of the code, version 1 CARDs also lack the hand index (hand 0).
+ * Appending to an older file is refused (see open).
+ */
+class HandJournal {
+public:
+    enum Tag : uint8_t {
+        TagSession = 1, TagSeat, TagRound, TagBet, TagCard, TagAction, TagSettle, TagEnd
+    };
+    enum Outcome : uint8_t { OutcomeLoss = 0, OutcomeWin = 1, OutcomePush = 2 };
+    enum Action : uint8_t { ActionStand = 0, ActionHit = 1, ActionDouble = 2, ActionSplit = 3 };
+
+    static constexpr uint8_t kVersion = 3;
+    static constexpr int kDealerSeat = 0;
+
+    HandJournal() = default;
+    ~HandJournal();
+    HandJournal(const HandJournal&) = delete;
+    HandJournal& operator=(const HandJournal&) = delete;
+
+    // Opens (appends to) a journal file; starts a new session.
+    bool open(const std::string& path, int groupRounds = 32, size_t groupBytes = 64 * 1024);
+    bool close();                         // false if any commit failed
+    bool isOpen() const { return file != nullptr; }
+    bool failed() const { return writeFailed; }
+
+    // Round events (called by Table)
+    void beginRound(unsigned int deckSeed, int shoeIndex, size_t shoePosition);
+    void bet(const Player& p, int amount);
+    void card(const Player& p, int hand, uint8_t code);   // code: rank + suit (card.h)
+    void dealerCard(uint8_t code);
+    void action(const Player& p, Action a);
+    void settle(const Player& p, Outcome outcome, int delta);
+    void endRound();
+
+    // Forces buffered rounds to disk (write + fsync); false if that failed.
+    bool commit();
+
+    uint64_t syncCount() const { return syncs; }
+
+private:
+    FILE* file = nullptr;
+    std::vector<uint8_t> buf;
+    std::map<const Player*, uint32_t> seats;
+    uint32_t roundNo = 0;
+    int roundsPending = 0;
+    int groupRounds = 32;
+    size_t groupBytes = 64 * 1024;
+    uint64_t syncs = 0;
+    bool writeFailed = false;
+
+    uint32_t seatOf(const Player& p);
+    void putTag(Tag t) { buf.push_back(static_cast<uint8_t>(t)); }
+    void putVarint(uint64_t v);
+    void putSigned(int64_t v);
+};
+
+/**
+ * JournalReader
+ * - Decodes a journal file record by record (used by the replay and by
+ *   the hand store converter).
+ *
+ * Event fields by tag:
+ *   SEAT:   seat, a = starting money, name
+ *   ROUND:  a = round, b = deck seed, c = shoe index, d = shoe position
+ *   BET:    seat, a = amount
+ *   CARD:   seat, a = card value, b = hand index, c = card code
+ *           (-1 in files before version 3)
+ *   ACTION: seat, a = HandJournal::Action
+ *   SETTLE: seat, a = outcome, b = money delta
+ */
+struct JournalEvent {
+    uint8_t tag = 0;
+    uint32_t seat = 0;
+    int64_t a = 0, b = 0, c = 0, d = 0;
+    std::string name;
+};
+
+class JournalReader {
+public:
+    bool open(const std::string& path);
+    bool next(JournalEvent& ev);
+    const std::string& error() const { return err; }
+
+private:
+    std::vector<uint8_t> data;
+    size_t pos = 0;
+    uint8_t version = 0;
+    std::string err;
+
+    uint8_t byte(bool& bad);
+    uint64_t varint(bool& bad);
+    int64_t signedVarint(bool& bad);
+};
+
+/**
+ * JournalReplay
+ * - Result of replaying a journal through the real Player API: seats end
+ *   up with the same money, W/L/P counts and (for an interrupted round)
+ *   the same hands, split and doubled, as the live table had.
+ * - Money follows the recorded settlement deltas (what was actually
+ *   paid); every delta is also checked against the even-money result on
+ *   the replayed hand's stake, and each one that differs is listed in
+ *   `mismatches`.
+ * - The round's card codes (dealerCodes / seatCodes) keep suits, so
+ *   suit-dependent results such as side bets can be worked out again.
+ * - Only the last session in the file is kept.
+ */
+struct JournalReplay {
+    std::vector<Player> players;        // in seat order
+    std::vector<int> dealerHand;        // cards of the last (or open) round
+    std::vector<uint8_t> dealerCodes;   // the same cards as rank + suit codes (version 3+)
+    std::vector<std::vector<uint8_t>> seatCodes;   // [seat - 1]: codes dealt to the seat that round
+    uint32_t rounds = 0;                // completed rounds in the session
+    unsigned int deckSeed = 0;          // shoe info of the last round
+    int shoeIndex = 0;
+    size_t shoePosition = 0;
+    std::vector<std::string> mismatches; // "round R seat S hand H: paid X, expected Y"
+    std::string error;                  // empty on success
+};
+
+bool replayJournal(const std::string& path, JournalReplay& out);
+
+#endif // JOURNAL_H
@@ -0,0 +1,99 @@
+/*
+ * LatencyHistogram Implementation
+ * -------------------------------
+ * Bucket layout (kSubBits = 6):
+ *  - idx 0..63: exact values 0..63 ns
+ *  - after that, value v with highest set bit m lands in magnitude (m - 5)
+ *    and sub-bucket (v >> (m - 6)) - 64, i.e. the top 7 bits of v.
+ */
+
+#include "latency.h"
+#include <cstring>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+/**
+ * reset()
+ * -------
+ * Drops every sample.
+ */
+void LatencyHistogram::reset() {
+    std::memset(buckets, 0, sizeof(buckets));
+    total = 0;
+    maxNanos = 0;
+}
+
+// Index of the highest set bit (v must be non-zero).
+static int highestBit(uint64_t v) {
+#ifdef _MSC_VER
+    unsigned long idx;
+    _BitScanReverse64(&idx, v);
+    return static_cast<int>(idx);
+#else
+    return 63 - __builtin_clzll(v);
+#endif
+}
+
+int LatencyHistogram::bucketFor(uint64_t nanos) {
+    if (nanos < static_cast<uint64_t>(kSubCount)) return static_cast<int>(nanos);
+    const int shift = highestBit(nanos) - kSubBits;
+    int idx = (shift + 1) * kSubCount + static_cast<int>((nanos >> shift) - kSubCount);
+    if (idx >= kBucketCount) idx = kBucketCount - 1;   // clamp absurd values
+    return idx;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(int idx) {
+    if (idx < kSubCount) return static_cast<uint64_t>(idx);
+    const int shift = idx / kSubCount - 1;
+    const uint64_t sub = static_cast<uint64_t>(idx % kSubCount + kSubCount);
+    return ((sub + 1) << shift) - 1;
+}
+
+/**
+ * record(nanos)
+ * -------------
+ * O(1): one bit scan, one increment.
+ */
+void LatencyHistogram::record(uint64_t nanos) {
+    ++buckets[bucketFor(nanos)];
+    ++total;
+    if (nanos > maxNanos) maxNanos = nanos;
+}
+
+/**
+ * merge(other)
+ * ------------
+ * Adds other's samples into this histogram (e.g. to combine tables).
+ */
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (int i = 0; i < kBucketCount; ++i) buckets[i] += other.buckets[i];
+    total += other.total;
+    if (other.maxNanos > maxNanos) maxNanos = other.maxNanos;
+}
+
+/**
+ * percentile(p)
+ * -------------
+ * Walks the buckets until p% of samples are covered. The answer is the
+ * bucket's upper bound, capped at the exact max. Returns 0 when empty.
+ */
+uint64_t LatencyHistogram::percentile(double p) const {
+    if (total == 0) return 0;
+    if (p >= 100.0) return maxNanos;
+    uint64_t want = static_cast<uint64_t>(p / 100.0 * static_cast<double>(total) + 0.5);
+    if (want < 1) want = 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < kBucketCount; ++i) {
+        seen += buckets[i];
+        if (seen >= want) {
+            const uint64_t v = bucketUpperBound(i);
+            return v < maxNanos ? v : maxNanos;
+        }
+    }
+    return maxNanos;
+}
@@ -0,0 +1,72 @@
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <cstdint>
+#include "stats.h"
+
+/**
+ * LatencyHistogram
+ * - HDR-style log-linear histogram of nanosecond samples in fixed memory
+ *   (no allocation after construction, nothing grows with sample count).
+ * - Values below 64ns are exact; above that each power-of-two range is split
+ *   into 64 sub-buckets, so any reported percentile is within ~1.6%.
+ * - max() is tracked exactly.
+ *
+ * Helpers:
+ *  - record(ns): add one sample
+ *  - percentile(p): upper bound of the bucket holding the p-th percentile
+ *  - merge(other): add another histogram's counts into this one
+ */
+class LatencyHistogram {
+public:
+    static constexpr int kSubBits = 6;
+    static constexpr int kSubCount = 1 << kSubBits;          // 64 sub-buckets
+    static constexpr int kMagnitudes = 41;                    // up to ~2^46 ns
+    static constexpr int kBucketCount = kSubCount * kMagnitudes;
+
+    LatencyHistogram();
+
+    void record(uint64_t nanos);
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    uint64_t count() const { return total; }
+    uint64_t max() const { return maxNanos; }
+    uint64_t percentile(double p) const;   // p in [0, 100]
+
+private:
+    uint64_t buckets[kBucketCount];
+    uint64_t total;
+    uint64_t maxNanos;
+
+    static int bucketFor(uint64_t nanos);
+    static uint64_t bucketUpperBound(int idx);
+};
+
+/**
+ * RoundLatency
+ * - One histogram per server-side phase of a round.
+ */
+struct RoundLatency {
+    LatencyHistogram startRound;
+    LatencyHistogram playerAction;
+    LatencyHistogram dealerPlay;
+    LatencyHistogram settleBets;
+};
+
+/**
+ * ScopedLatency
+ * - Records the lifetime of the enclosing scope into a histogram.
+ */
+class ScopedLatency {
+public:
+    explicit ScopedLatency(LatencyHistogram& h) : hist(h), start(stats::nowNanos()) {}
+    ~ScopedLatency() { hist.record(stats::nowNanos() - start); }
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+private:
+    LatencyHistogram& hist;
+    uint64_t start;
+};
+
+#endif // LATENCY_H
@@ -0,0 +1,365 @@
+/*
+ * Load Generator Implementation
+ * -----------------------------
+ * Threads per step:
+ *  - one scheduler: a min-heap of requests keyed by the time their think
+ *    time ends; due requests are handed to the owning worker in batches
+ *  - `workers` engine threads: table k belongs to worker k % workers, so a
+ *    table is only ever touched by one thread; a worker serves its inbox,
+ *    records each request's latency and pushes the follow-up requests
+ *    (with fresh think times) back to the scheduler in one batch
+ * Only the middle of a step is measured (after warm-up, before teardown).
+ */
+
+#include "loadgen.h"
+#include "deck.h"
+#include "player.h"
+#include "strategy.h"
+#include "table.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <thread>
+
+using namespace std;
+
+namespace {
+
+using Clock = chrono::steady_clock;
+
+struct Request {
+    Clock::time_point due;      // end of the think time
+    uint32_t table;
+    uint8_t seat;
+};
+
+struct Later {
+    bool operator()(const Request& a, const Request& b) const { return a.due > b.due; }
+};
+
+struct LoadTable {
+    Deck deck;
+    Table table;
+    vector<Player> seats;       // reserved up front: the Table keeps pointers
+    int betsIn = 0;
+    int turn = -1;              // seat to act, -1 while bets are collected
+
+    LoadTable(unsigned int seed, int seatCount) : deck(seed, 6), table(deck) {
+        seats.reserve(static_cast<size_t>(seatCount));
+        for (int s = 0; s < seatCount; ++s) {
+            seats.emplace_back("seat" + to_string(s + 1), 1 << 30);
+            table.addPlayer(&seats.back());
+        }
+        table.setQuiet(true);
+    }
+};
+
+struct Worker {
+    mutex m;
+    condition_variable cv;
+    vector<Request> inbox;
+    LatencyHistogram latency;
+    uint64_t served = 0;
+    mt19937 rng;
+};
+
+class LoadEngine {
+public:
+    LoadEngine(const LoadConfig& cfg, int sessions);
+    ~LoadEngine();
+
+    void setRecording(bool on) { recording.store(on, memory_order_relaxed); }
+    void stop();                // joins every thread; call before merge()
+    void merge(LatencyHistogram& latency, uint64_t& served) const;
+
+private:
+    const LoadConfig& cfg;
+    vector<unique_ptr<LoadTable>> tables;
+    vector<unique_ptr<Worker>> workers;
+    BasicStrategy basic;
+
+    mutex schedMutex;
+    condition_variable schedCv;
+    priority_queue<Request, vector<Request>, Later> heap;
+
+    atomic<bool> stopping{ false };
+    atomic<bool> recording{ false };
+    vector<thread> threads;
+
+    Clock::duration think(const ThinkTime& t, mt19937& rng) const;
+    void serve(uint32_t index, const Request& r, mt19937& rng, vector<Request>& next);
+    void schedulerLoop();
+    void workerLoop(Worker& w);
+};
+
+LoadEngine::LoadEngine(const LoadConfig& cfg, int sessions) : cfg(cfg) {
+    const int seatsPer = max(cfg.seatsPerTable, 1);
+    const int tableCount = (sessions + seatsPer - 1) / seatsPer;
+    size_t n = cfg.workers > 0 ? static_cast<size_t>(cfg.workers) : thread::hardware_concurrency();
+    if (cfg.workers <= 0 && n > 1) --n;   // leave a core for the scheduler
+    if (n == 0) n = 1;
+
+    for (size_t w = 0; w < n; ++w) {
+        workers.emplace_back(new Worker());
+        workers.back()->rng.seed(cfg.seed + static_cast<unsigned int>(w) * 7919u);
+    }
+    const Clock::time_point now = Clock::now();
+    for (int k = 0; k < tableCount; ++k) {
+        const int seats = min(seatsPer, sessions - k * seatsPer);
+        tables.emplace_back(new LoadTable(cfg.seed * 1000003u + static_cast<unsigned int>(k), seats));
+        mt19937& rng = workers[static_cast<size_t>(k) % n]->rng;
+        for (int s = 0; s < seats; ++s)
+            heap.push(Request{ now + think(cfg.betThink, rng), static_cast<uint32_t>(k), static_cast<uint8_t>(s) });
+    }
+
+    threads.emplace_back([this]() { schedulerLoop(); });
+    for (auto& w : workers) {
+        Worker* wp = w.get();
+        threads.emplace_back([this, wp]() { workerLoop(*wp); });
+    }
+}
+
+LoadEngine::~LoadEngine() { stop(); }
+
+void LoadEngine::stop() {
+    if (threads.empty()) return;
+    stopping.store(true);
+    { lock_guard<mutex> g(schedMutex); }
+    schedCv.notify_all();
+    for (auto& w : workers) {
+        { lock_guard<mutex> g(w->m); }
+        w->cv.notify_all();
+    }
+    for (thread& t : threads) t.join();
+    threads.clear();
+}
+
+// Reads the workers' histograms; only safe once stop() has joined them.
+void LoadEngine::merge(LatencyHistogram& latency, uint64_t& served) const {
+    for (const auto& w : workers) {
+        latency.merge(w->latency);
+        served += w->served;
+    }
+}
+
+Clock::duration LoadEngine::think(const ThinkTime& t, mt19937& rng) const {
+    lognormal_distribution<double> d(log(max(t.medianSeconds, 1e-9)), t.sigma);
+    return chrono::duration_cast<Clock::duration>(chrono::duration<double>(d(rng) * cfg.thinkScale));
+}
+
+/**
+ * serve(index, request, rng, next)
+ * --------------------------------
+ * One request against table `index`, through the same Table calls as
+ * the driver: a bet (the last bet deals the round) or the acting seat's
+ * decision. Follow-ups go to `next`: the same seat again after a hit,
+ * the next seat with a decision to make, or everyone's next bet once
+ * the dealer has played and the round is settled.
+ */
+void LoadEngine::serve(uint32_t index, const Request& r, mt19937& rng, vector<Request>& next) {
+    LoadTable& t = *tables[index];
+    const int n = static_cast<int>(t.seats.size());
+    const Clock::time_point now = Clock::now();
+
+    if (t.turn < 0) {
+        t.seats[r.seat].setBet(10);
+        if (++t.betsIn < n) return;
+        t.betsIn = 0;
+        t.table.startRound();
+        t.turn = 0;
+    }
+    else {
+        Player& p = t.seats[r.seat];
+        const HandContext c = makeContext(p, 0, t.table);
+        bool done = true;
+        if (decideDouble(basic, c)) {
+            t.table.playerDouble(p, 0);
+        }
+        else if (decideHit(basic, c)) {
+            t.table.playerHit(p, 0);
+            done = p.handValue() >= 21;
+        }
+        else {
+            t.table.playerStand(p);
+        }
+        if (!done) {
+            next.push_back(Request{ now + think(cfg.decisionThink, rng), index, r.seat });
+            return;
+        }
+        ++t.turn;
+    }
+
+    while (t.turn < n && t.seats[t.turn].handValue() >= 21) ++t.turn;   // nothing to decide
+    if (t.turn < n) {
+        next.push_back(Request{ now + think(cfg.decisionThink, rng), index, static_cast<uint8_t>(t.turn) });
+        return;
+    }
+    t.table.dealerPlay();
+    t.table.settleBets();
+    t.turn = -1;
+    for (int s = 0; s < n; ++s)
+        next.push_back(Request{ now + think(cfg.betThink, rng), index, static_cast<uint8_t>(s) });
+}
+
+void LoadEngine::schedulerLoop() {
+    vector<vector<Request>> batches(workers.size());
+    unique_lock<mutex> lock(schedMutex);
+    while (!stopping.load()) {
+        if (heap.empty()) {
+            schedCv.wait(lock);
+            continue;
+        }
+        const Clock::time_point due = heap.top().due;
+        if (due > Clock::now()) {
+            schedCv.wait_until(lock, due);
+            continue;
+        }
+        const Clock::time_point now = Clock::now();
+        while (!heap.empty() && heap.top().due <= now) {
+            batches[heap.top().table % workers.size()].push_back(heap.top());
+            heap.pop();
+        }
+        lock.unlock();
+        for (size_t w = 0; w < workers.size(); ++w) {
+            if (batches[w].empty()) continue;
+            {
+                lock_guard<mutex> g(workers[w]->m);
+                workers[w]->inbox.insert(workers[w]->inbox.end(), batches[w].begin(), batches[w].end());
+            }
+            workers[w]->cv.notify_one();
+            batches[w].clear();
+        }
+        lock.lock();
+    }
+}
+
+void LoadEngine::workerLoop(Worker& w) {
+    vector<Request> work, next;
+    while (true) {
+        {
+            unique_lock<mutex> lock(w.m);
+            w.cv.wait(lock, [&]() { return stopping.load() || !w.inbox.empty(); });
+            if (stopping.load()) return;
+            swap(work, w.inbox);
+        }
+        for (const Request& r : work) {
+            serve(r.table, r, w.rng, next);
+            if (recording.load(memory_order_relaxed)) {
+                const auto waited = chrono::duration_cast<chrono::nanoseconds>(Clock::now() - r.due).count();
+                w.latency.record(static_cast<uint64_t>(max<long long>(waited, 0)));
+                ++w.served;
+            }
+        }
+        work.clear();
+        if (next.empty()) continue;
+        {
+            lock_guard<mutex> g(schedMutex);
+            for (const Request& r : next) heap.push(r);
+        }
+        schedCv.notify_one();
+        next.clear();
+    }
+}
+
+double micros(uint64_t ns) { return ns / 1000.0; }
+
+} // namespace
+
+/**
+ * runLoadStep(cfg, sessions)
+ * --------------------------
+ * Runs `sessions` sessions for cfg.stepSeconds; the step passes if the
+ * measured p99 is within cfg.p99TargetUs.
+ */
+LoadStep runLoadStep(const LoadConfig& cfg, int sessions) {
+    LoadStep step;
+    step.sessions = sessions;
+    {
+        LoadEngine engine(cfg, sessions);
+        const chrono::duration<double> total(max(cfg.stepSeconds, 0.01));
+        this_thread::sleep_for(total * cfg.warmupFraction);
+        engine.setRecording(true);
+        const Clock::time_point start = Clock::now();
+        this_thread::sleep_for(total * (1.0 - cfg.warmupFraction));
+        engine.setRecording(false);
+        step.seconds = chrono::duration<double>(Clock::now() - start).count();
+        engine.stop();
+        engine.merge(step.latency, step.requests);
+    }
+    step.passed = step.requests > 0 && micros(step.latency.percentile(99.0)) <= cfg.p99TargetUs;
+    return step;
+}
+
+/**
+ * runLoadRamp(cfg)
+ * ----------------
+ * Doubling steps, then bisection between the last pass and first miss.
+ */
+LoadResult runLoadRamp(const LoadConfig& cfg) {
+    LoadResult out;
+    int pass = 0, fail = 0;
+    int n = max(min(cfg.startSessions, cfg.maxSessions), 1);
+    while (true) {
+        out.steps.push_back(runLoadStep(cfg, n));
+        if (!out.steps.back().passed) { fail = n; break; }
+        pass = n;
+        if (n >= cfg.maxSessions) break;
+        n = min(n * 2, cfg.maxSessions);
+    }
+    for (int i = 0; i < cfg.refineSteps && pass > 0 && fail > 0 && fail - pass > 1; ++i) {
+        const int mid = pass + (fail - pass) / 2;
+        out.steps.push_back(runLoadStep(cfg, mid));
+        if (out.steps.back().passed) pass = mid;
+        else fail = mid;
+    }
+    out.maxSustainable = pass;
+    return out;
+}
+
+/**
+ * runLoadTool(maxSessions, p99TargetUs, thinkScale, stepSeconds, workers)
+ * -----------------------------------------------------------------------
+ * Prints every step (request rate and latency percentiles in us) and the
+ * largest session count that met the target.
+ */
+int runLoadTool(int maxSessions, double p99TargetUs, double thinkScale, double stepSeconds, int workers) {
+    if (maxSessions <= 0 || p99TargetUs <= 0 || thinkScale <= 0 || stepSeconds <= 0) {
+        cout << "usage: load [max sessions] [p99 target us] [think scale] [step seconds] [workers]\n";
+        return 1;
+    }
+    LoadConfig cfg;
+    cfg.maxSessions = maxSessions;
+    cfg.startSessions = min(cfg.startSessions, maxSessions);
+    cfg.p99TargetUs = p99TargetUs;
+    cfg.thinkScale = thinkScale;
+    cfg.stepSeconds = stepSeconds;
+    cfg.workers = workers;
+
+    cout << "=== Load ramp: " << cfg.seatsPerTable << " seats/table, think x" << thinkScale
+         << ", p99 target " << p99TargetUs << " us ===\n";
+    cout << right << setw(9) << "Sessions" << setw(11) << "Req/s" << setw(10) << "p50"
+         << setw(10) << "p99" << setw(10) << "p99.9" << setw(10) << "max" << "  Result\n";
+    cout << fixed << setprecision(1);
+
+    const LoadResult r = runLoadRamp(cfg);
+    for (const LoadStep& s : r.steps) {
+        cout << setw(9) << s.sessions << setw(11) << s.requestsPerSecond()
+             << setw(10) << micros(s.latency.percentile(50.0)) << setw(10) << micros(s.latency.percentile(99.0))
+             << setw(10) << micros(s.latency.percentile(99.9)) << setw(10) << micros(s.latency.max())
+             << "  " << (s.passed ? "ok" : "MISS") << "\n";
+    }
+    cout << "max sustainable sessions: " << r.maxSustainable;
+    if (r.maxSustainable == cfg.maxSessions) cout << " (the cap; no miss found)";
+    if (thinkScale != 1.0)
+        cout << " (~" << static_cast<long long>(r.maxSustainable / thinkScale) << " at human pace)";
+    cout << "\n";
+    return 0;
+}
@@ -0,0 +1,70 @@
+#ifndef LOADGEN_H
+#define LOADGEN_H
+
+#include <cstdint>
+#include <vector>
+#include "latency.h"
+
+/**
+ * Load generator
+ * - Simulated human sessions play real Tables in-process: every bet and
+ *   every hit/stand/double is a request that waits out a think time, goes
+ *   through a scheduler thread to the engine worker that owns the table
+ *   (a mutex-guarded inbox, no network), and is served with the same Table
+ *   calls the driver makes.
+ * - Sessions sit `seatsPerTable` to a table and play in turn: all bets in
+ *   -> deal; seats act one at a time; the dealer plays and settles after
+ *   the last seat. Decisions follow basic strategy (no splits).
+ * - Think times are log-normal (median, sigma of ln), the usual shape of
+ *   human reaction times; thinkScale shrinks them all to push more
+ *   requests per session (a session at scale s loads the engine like 1/s
+ *   human-paced ones).
+ * - Latency of a request = served time - the time its think time ended,
+ *   so scheduler lag and queueing count against the target.
+ *
+ * Ramp: sessions double from startSessions until a step's p99 misses the
+ * target (or maxSessions), then a few bisection steps between the last
+ * passing and the first failing count (none if the first step misses).
+ */
+struct ThinkTime {
+    double medianSeconds = 1.0;
+    double sigma = 0.5;
+};
+
+struct LoadConfig {
+    int startSessions = 64;
+    int maxSessions = 8192;
+    int refineSteps = 2;            // bisection steps after the first miss
+    int seatsPerTable = 5;
+    double stepSeconds = 3.0;
+    double warmupFraction = 0.25;   // start of each step not measured
+    double p99TargetUs = 20000.0;   // well under what a person notices
+    double thinkScale = 1.0;
+    ThinkTime betThink{ 3.0, 0.5 };
+    ThinkTime decisionThink{ 1.5, 0.6 };
+    int workers = 0;                // engine threads, 0 = cores - 1
+    unsigned int seed = 1;
+};
+
+struct LoadStep {
+    int sessions = 0;
+    uint64_t requests = 0;          // served during the measured window
+    double seconds = 0.0;           // length of the measured window
+    LatencyHistogram latency;       // ns
+    bool passed = false;
+
+    double requestsPerSecond() const { return seconds > 0 ? requests / seconds : 0.0; }
+};
+
+struct LoadResult {
+    std::vector<LoadStep> steps;    // in the order they ran
+    int maxSustainable = 0;         // most sessions that met the target (0 = none)
+};
+
+LoadStep runLoadStep(const LoadConfig& cfg, int sessions);
+LoadResult runLoadRamp(const LoadConfig& cfg);
+
+// Driver mode "load [max sessions] [p99 target us] [think scale] [step seconds] [workers]".
+int runLoadTool(int maxSessions, double p99TargetUs, double thinkScale, double stepSeconds, int workers);
+
+#endif // LOADGEN_H
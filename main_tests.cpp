@@ -13,11 +13,38 @@
 #include "dealer.h"
 #include "person.h"
 #include "table.h"
+#include "stats.h"
+#include "latency.h"
+#include "strategy.h"
+#include "journal.h"
+#include "handstore.h"
+#include "shoe_pipeline.h"
+#include "player_store.h"
+#include "card.h"
+#include "sidebet.h"
+#include "simulation.h"
+#include "ruin.h"
+#include "betramp.h"
+#include "deviation.h"
+#include "endgame.h"
+#include "render.h"
+#include "loadgen.h"
+#include "spectator.h"
+#include "checkpoint.h"
+#include "sessions.h"
+#include "numa.h"
+#include "wallet.h"
+#include "rules.h"
 #include <iostream>
 #include <vector>
 #include <string>
 #include <iomanip>
 #include <algorithm>
+#include <cstdio>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <chrono>
 
 using namespace std;
 
@@ -259,6 +286,1192 @@ int notmain()
 
     cout << "\n=== Table Tests complete ===\n";
 
+    // -------------------------------------------------
+    // Engine stats (counters are global, so check deltas)
+    // -------------------------------------------------
+    section("Engine stats");
+    {
+#if CLUB_STATS
+        stats::Snapshot before = stats::snapshotStats();
+#endif
+
+        Deck sd;
+        for (int i = 0; i < 53; ++i) sd.deal();   // never shuffled: reshuffles at card 1 and 53
+
+        Player carol("Carol", 100);
+        Table st(sd);
+        st.addPlayer(&carol);
+        carol.setBet(10);
+        carol.cardDealt(10); carol.cardDealt(10);  // 20
+        st.testClearDealer();
+        st.testDealToDealer(10);
+        st.testDealToDealer(8);                    // 18
+        st.settleBets();
+
+        stats::Snapshot after = stats::snapshotStats();
+#if CLUB_STATS
+        CHECK(after.counters[stats::CardsDealt] - before.counters[stats::CardsDealt] == 53);
+        CHECK(after.counters[stats::Reshuffles] - before.counters[stats::Reshuffles] == 2);
+        CHECK(after.counters[stats::PlayerWins] - before.counters[stats::PlayerWins] == 1);
+        CHECK(after.phaseCalls[stats::PhaseSettle] - before.phaseCalls[stats::PhaseSettle] == 1);
+#endif
+        CHECK(after.toJson().find("\"cards_dealt\":") != string::npos);
+        CHECK(after.toText().find("phase.settle") != string::npos);
+    }
+
+    // -------------------------------------------------
+    // Latency histogram
+    // -------------------------------------------------
+    section("Latency histogram");
+    {
+        LatencyHistogram h;
+        CHECK(h.percentile(50.0) == 0);
+        for (uint64_t v = 1; v <= 1000; ++v) h.record(v * 1000);   // 1us..1ms
+        CHECK(h.count() == 1000);
+        CHECK(h.max() == 1000000);
+
+        // within the ~1.6% bucket precision
+        const uint64_t p50 = h.percentile(50.0);
+        const uint64_t p99 = h.percentile(99.0);
+        CHECK(p50 >= 500000 && p50 <= 508000);
+        CHECK(p99 >= 990000 && p99 <= 1000000);
+        CHECK(h.percentile(100.0) == 1000000);
+
+        LatencyHistogram other;
+        other.record(5);
+        h.merge(other);
+        CHECK(h.count() == 1001);
+        CHECK(h.percentile(0.01) == 5);
+    }
+
+    // -------------------------------------------------
+    // Bot strategies
+    // -------------------------------------------------
+    section("Bot strategies");
+    {
+        HandContext c;
+        c.total = 16; c.dealerUp = 10; c.cardsLeft = 52; c.shoeId = 1;
+
+        BasicStrategy basic;
+        CHECK(basic.shouldHit(c) == true);     // 16 vs 10: hit
+        c.dealerUp = 6;
+        CHECK(basic.shouldHit(c) == false);    // 16 vs 6: stand
+        c.total = 18; c.soft = true; c.dealerUp = 10;
+        CHECK(basic.shouldHit(c) == true);     // soft 18 vs 10: hit
+
+        HitBelow below{ 15 };
+        c.total = 14; c.soft = false;
+        CHECK(decideHit(below, c) == true);
+        c.total = 15;
+        CHECK(decideHit(below, c) == false);
+
+        // positive count: 16 vs 10 becomes a stand
+        HiLoCounting hilo;
+        for (int i = 0; i < 6; ++i) hilo.observe(5, 1);
+        c.total = 16; c.dealerUp = 10;
+        CHECK(hilo.trueCount(52) == 6.0);
+        CHECK(hilo.shouldHit(c) == false);
+        hilo.observe(10, 2);                   // new shoe resets the count
+        CHECK(hilo.runningCount == -1);
+
+        BotStrategy v = MimicDealer{ true };
+        c.total = 17; c.soft = true;
+        CHECK(decideHit(v, c) == true);        // hits soft 17 like an H17 dealer
+        CHECK(string(strategyName(v)) == "mimic-dealer");
+
+        Deck bd;
+        bd.shuffle();
+        Player bot("Bot", 100);
+        Table bt(bd);
+        bt.addPlayer(&bot);
+        bot.setBet(5);
+        bt.startRound();
+        BasicStrategy b2;
+        playBotTurn(b2, bot, bt);
+        CHECK(bot.handValue() >= 12 || bot.isSoft());   // basic never stands on hard 11 or less
+    }
+
+    // -------------------------------------------------
+    // Hand journal: record rounds, replay, compare
+    // -------------------------------------------------
+    section("Hand journal");
+    {
+        const string path = "test_journal.bin";
+        std::remove(path.c_str());
+
+        Deck jd(1234u);
+        jd.shuffle();
+        Player ann("Ann", 300);
+        Player ben("Ben", 200);
+        Table jt(jd);
+        jt.addPlayer(&ann);
+        jt.addPlayer(&ben);
+
+        HandJournal journal;
+        CHECK(journal.open(path, /*groupRounds=*/4));
+        jt.setJournal(&journal);
+
+        BasicStrategy bs;
+        HitBelow hb{ 15 };
+        for (int round = 0; round < 10; ++round) {
+            ann.setBet(10);
+            ben.setBet(5);
+            jt.startRound();
+            playBotTurn(bs, ann, jt);
+            playBotTurn(hb, ben, jt);
+            jt.dealerPlay();
+            jt.settleBets();
+        }
+        CHECK(journal.syncCount() == 2);   // 10 rounds, commits at 4 and 8
+        CHECK(!journal.failed());
+        CHECK(journal.close());
+
+        JournalReplay r;
+        CHECK(replayJournal(path, r));
+        CHECK(r.rounds == 10);
+        CHECK(r.players.size() == 2);
+        if (r.players.size() == 2) {
+            CHECK(r.players[0].getName() == "Ann");
+            CHECK(r.players[0].getMoney() == ann.getMoney());
+            CHECK(r.players[0].getWins() == ann.getWins());
+            CHECK(r.players[0].getPushes() == ann.getPushes());
+            CHECK(r.players[1].getMoney() == ben.getMoney());
+            CHECK(r.players[1].getLosses() == ben.getLosses());
+        }
+        CHECK(r.deckSeed == 1234u && r.mismatches.empty());
+        std::remove(path.c_str());
+
+        // replay pays what was recorded and reports a payout the rules don't give
+        {
+            Player pay("Pay", 100);
+            HandJournal pj;
+            CHECK(pj.open(path));
+            pj.beginRound(1u, 1, 0);
+            pj.bet(pay, 10);
+            pj.card(pay, 0, card::make(card::Ace, card::Hearts));
+            pj.card(pay, 0, card::make(card::King, card::Hearts));
+            pj.settle(pay, HandJournal::OutcomeWin, 15);   // 3:2 blackjack, not even money
+            pj.endRound();
+            pj.close();
+        }
+        JournalReplay pr;
+        CHECK(replayJournal(path, pr) && pr.players.size() == 1 && pr.mismatches.size() == 1);
+        if (pr.players.size() == 1) CHECK(pr.players[0].getMoney() == 115 && pr.players[0].getWins() == 1);
+        CHECK(pr.seatCodes.size() == 1 && pr.seatCodes[0].size() == 2 && card::suit(pr.seatCodes[0][0]) == card::Hearts);
+        std::remove(path.c_str());
+
+        // a split with one hand doubled, then a round cut off after a split
+        auto code = [](int v) { return card::make(v == 11 ? 0 : v - 1, card::Spades); };
+        vector<uint8_t> stack;
+        for (int v : { 8, 10, 8, 7, 3, 10, 10, 8, 10, 8, 7, 2, 5 }) stack.insert(stack.begin(), code(v));
+        Deck sd(5u);
+        sd.loadCards(stack);
+        Player sam("Sam", 300);
+        Table st(sd);
+        st.addPlayer(&sam);
+        HandJournal sj;
+        CHECK(sj.open(path));
+        st.setJournal(&sj);
+        sam.setBet(10);
+        st.startRound();                                  // 8,8 vs dealer 10,7
+        const int other = st.playerSplit(sam, 0);         // 8+3, 8+10
+        CHECK(other == 1 && st.playerDouble(sam, 0));     // 8+3+10 = 21 for $20
+        st.playerStand(sam);
+        st.dealerPlay();
+        st.settleBets();                                  // +20 +10
+        CHECK(sam.getMoney() == 330);
+        st.startRound();
+        st.playerSplit(sam, 0);                           // 8+2, 8+5 and no more
+        sj.close();
+
+        JournalReplay sr;
+        CHECK(replayJournal(path, sr) && sr.rounds == 1 && sr.players.size() == 1 && sr.mismatches.empty());
+        if (sr.players.size() == 1) {
+            const Player& back = sr.players[0];
+            CHECK(back.getMoney() == 330 && back.getWins() == 2);
+            CHECK(back.handCount() == 2 && back.handAt(0).value() == 10 && back.handAt(1).value() == 13);
+            CHECK(back.betOn(1) == 10);
+        }
+        // card codes (suits included) of the open round
+        CHECK(sr.seatCodes.size() == 1 && sr.seatCodes[0] == vector<uint8_t>({ code(8), code(8), code(2), code(5) }));
+        CHECK(sr.dealerCodes == vector<uint8_t>({ code(10), code(7) }) && sr.dealerHand == vector<int>({ 10, 7 }));
+        const string store = "test_journal.cphs";
+        CHECK(convertJournal(path, store) == 2);
+        HandQuery sq;
+        HandQueryResult sqr;
+        CHECK(runHandQuery(store, sq, sqr) && sqr.totalBet == 30 && sqr.totalNet == 30);
+        std::remove(store.c_str());
+        std::remove(path.c_str());
+    }
+
+    // -------------------------------------------------
+    // Columnar hand store
+    // -------------------------------------------------
+    section("Hand store");
+    {
+        const string path = "test_hands.cphs";
+        std::remove(path.c_str());
+
+        HandStoreWriter w;
+        CHECK(w.open(path));
+        // 70000 rows -> two blocks; every 7th row is a 16 vs 10 hit
+        long long expectWins = 0, expectNet = 0, expectMatched = 0;
+        for (int i = 0; i < 70000; ++i) {
+            HandRow row;
+            const bool cell = (i % 7 == 0);
+            row.playerTotal = cell ? 16 : 12 + i % 9;
+            row.dealerUp = cell ? 10 : 2 + i % 8;
+            row.action = cell ? 1 : 0;
+            row.outcome = i % 3;                       // loss, win, push
+            row.bet = (i % 5 == 0) ? 1000 : 10;        // forces a 2-byte column
+            row.net = row.outcome == 1 ? row.bet : row.outcome == 0 ? -row.bet : 0;
+            w.append(row);
+            if (cell) {
+                ++expectMatched;
+                expectWins += (row.outcome == 1);
+                expectNet += row.net;
+            }
+        }
+        CHECK(w.close());
+        CHECK(!w.failed());
+
+        HandQuery q;
+        q.playerTotal = 16; q.dealerUp = 10; q.action = 1; q.threads = 2;
+        HandQueryResult r;
+        CHECK(runHandQuery(path, q, r));
+        CHECK(r.rows == 70000);
+        CHECK(static_cast<long long>(r.matched) == expectMatched);
+        CHECK(static_cast<long long>(r.wins) == expectWins);
+        CHECK(r.totalNet == expectNet);
+        CHECK(r.wins + r.losses + r.pushes == r.matched);
+
+        // malformed filters are rejected instead of throwing or matching everything
+        char tool[] = "handstore", query[] = "query", store[] = "test_hands.cphs";
+        char badTotal[] = "total=1x", badAction[] = "action=hold";
+        char* badArgs1[] = { tool, query, store, badTotal };
+        char* badArgs2[] = { tool, query, store, badAction };
+        CHECK(runHandStoreTool(4, badArgs1) == 1);
+        CHECK(runHandStoreTool(4, badArgs2) == 1);
+        std::remove(path.c_str());
+
+        // a hand-crafted block whose first column claims 3-byte values
+        if (FILE* bad = fopen(path.c_str(), "wb")) {
+            const uint8_t header[8] = { 'C', 'P', 'H', 'S', 1, 0, 0, 0 };
+            const uint32_t rows = 4, payload = 12;
+            const uint8_t desc[4] = { 3, 0, 0, 0 };
+            const int32_t base = 0;
+            const uint8_t bytes[12] = {};
+            fwrite(header, 1, sizeof(header), bad);
+            fwrite(&rows, sizeof(rows), 1, bad);
+            fwrite(desc, 1, sizeof(desc), bad);
+            fwrite(&base, sizeof(base), 1, bad);
+            fwrite(&payload, sizeof(payload), 1, bad);
+            fwrite(bytes, 1, sizeof(bytes), bad);
+            fclose(bad);
+        }
+        HandQueryResult corrupt;
+        CHECK(!runHandQuery(path, HandQuery(), corrupt) && corrupt.error == "corrupt block");
+        std::remove(path.c_str());
+    }
+
+    // -------------------------------------------------
+    // Shoe pipeline: same cards as in-place shuffles
+    // -------------------------------------------------
+    section("Shoe pipeline");
+    {
+        Deck plain(99u, 2);
+        Deck piped(99u, 2);
+        ShoePipeline pipe(piped, 2);
+        piped.attachPipeline(&pipe);
+
+        CHECK(piped.shoeSize() == 104);
+        bool same = true;
+        for (int i = 0; i < 104 * 5 + 7; ++i) same = same && (plain.deal() == piped.deal());
+        CHECK(same);
+        CHECK(piped.shuffleCount() == plain.shuffleCount());
+        CHECK(piped.shuffleCount() == 6);
+        CHECK(piped.shoePosition() == 7);
+
+
+        // going back: the queued shoes (11, 12) are past the wanted one, so the
+        // producer restarts after it instead of waiting on a full ring
+        Deck back(5u, 1);
+        back.loadShoe(10);
+        ShoePipeline backPipe(back, 2);
+        back.attachPipeline(&backPipe);
+        for (int i = 0; i < 1000 && backPipe.readyCount() < 2; ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        Deck backPlain(5u, 1);
+        back.loadShoe(2);
+        backPlain.loadShoe(2);
+        for (int i = 0; i < 52 + 1; ++i) same = same && (backPlain.deal() == back.deal());
+        CHECK(same && back.shuffleCount() == 3);
+        for (int i = 0; i < 1000 && backPipe.readyCount() < 2; ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        vector<uint8_t> taken, built;
+        Deck::buildShoe(built, 5u, 1, 4);
+        CHECK(backPipe.takeShoe(taken, 4) && taken == built);
+    }
+
+    // -------------------------------------------------
+    // Structure-of-arrays player store
+    // -------------------------------------------------
+    section("Player store");
+    {
+        PlayerStore ps;
+        const size_t a = ps.addSeat("Ann", 500);
+        const size_t b = ps.addSeat("Ben", 500);
+        const size_t c = ps.addSeat("Ann", 300);   // same name, interned once
+        CHECK(ps.size() == 3);
+        CHECK(ps.nameId[a] == ps.nameId[c]);
+        CHECK(ps.name(b) == "Ben");
+
+        ps.dealTo(a, 11); ps.dealTo(a, 11);        // A+A = soft 12
+        CHECK(ps.handValue(a) == 12);
+        CHECK(ps.isSoft(a));
+        ps.dealTo(a, 9);                           // soft 21
+        CHECK(ps.handValue(a) == 21);
+        ps.dealTo(b, 10); ps.dealTo(b, 6); ps.dealTo(b, 10);   // bust
+        PlayerStore aces;                          // every ace drops to 1 as needed
+        const size_t s0 = aces.addSeat("A,A,10", 100);
+        const size_t s1 = aces.addSeat("A,A,A,9", 100);
+        aces.dealTo(s0, 11); aces.dealTo(s0, 11); aces.dealTo(s0, 10);
+        aces.dealTo(s1, 11); aces.dealTo(s1, 11); aces.dealTo(s1, 11); aces.dealTo(s1, 9);
+        CHECK(aces.handValue(s0) == 12 && !aces.isSoft(s0));
+        CHECK(aces.handValue(s1) == 12 && !aces.isSoft(s1));
+        const Hand aa10{ 11, 11, 10 }, aaa9{ 11, 11, 11, 9 };   // Hand agrees
+        CHECK(aa10.value() == aces.handValue(s0) && aa10.isSoft() == aces.isSoft(s0));
+        CHECK(aaa9.value() == aces.handValue(s1) && aaa9.isSoft() == aces.isSoft(s1));
+        ps.dealTo(c, 10); ps.dealTo(c, 8);         // 18
+
+        Deck sd2;
+        Table st2(sd2);
+        st2.testClearDealer();
+        st2.testDealToDealer(10);
+        st2.testDealToDealer(8);                   // dealer 18
+        for (size_t i = 0; i < ps.size(); ++i) ps.bet[i] = 20;
+        st2.settleBets(ps);
+        CHECK(ps.money[a] == 520 && ps.wins[a] == 1);
+        CHECK(ps.money[b] == 480 && ps.losses[b] == 1);
+        CHECK(ps.money[c] == 300 && ps.pushes[c] == 1);
+        CHECK(ps.net(b) == -20);
+        CHECK(ps.cardCount[a] == 0);               // hands cleared after settling
+
+        Deck sd3(5u);
+        Table st3(sd3);
+        st3.startRound(ps);
+        CHECK(ps.cardCount[a] == 2 && ps.cardCount[c] == 2);
+        CHECK(st3.dealerUpCard() > 0);
+    }
+
+    section("Fused rounds");
+    {
+        Deck fd(11u, 6);
+        Table ft(fd);
+        Player f1("F1", 1000), f2("F2", 1000), broke("Broke", 0);
+        f1.setBet(10); f2.setBet(25);
+        ft.addPlayer(&f1); ft.addPlayer(&f2); ft.addPlayer(&broke);
+
+        vector<RoundResult> results(200);
+        BasicStrategy basic;
+        const size_t played = ft.playRounds(results.size(), basic, results.data());
+        CHECK(played == results.size());
+
+        long long net = 0;
+        int hands = 0;
+        bool seatsOk = true;
+        for (const RoundResult& r : results) {
+            net += r.net;
+            hands += r.wins + r.losses + r.pushes;
+            seatsOk = seatsOk && r.seatsPlayed == 2;
+        }
+        CHECK(seatsOk);                             // broke seat sat out
+        CHECK(hands >= 400);                        // splits add hands
+        CHECK(hands == f1.getWins() + f1.getLosses() + f1.getPushes()
+                     + f2.getWins() + f2.getLosses() + f2.getPushes());
+        CHECK(net == f1.getNet() + f2.getNet());
+        CHECK(f1.getHand().empty() && f2.getHand().empty());
+        CHECK(broke.getWins() + broke.getLosses() + broke.getPushes() == 0);
+
+        // same seed -> same rounds
+        Deck fd2(11u, 6);
+        Table ft2(fd2);
+        Player g1("G1", 1000), g2("G2", 1000);
+        g1.setBet(10); g2.setBet(25);
+        ft2.addPlayer(&g1); ft2.addPlayer(&g2);
+        vector<RoundResult> again(200);
+        ft2.playRounds(again.size(), basic, again.data());
+        CHECK(g1.getMoney() == f1.getMoney() && g2.getMoney() == f2.getMoney());
+    }
+
+    section("Side bets");
+    {
+        using card::make;
+        const uint8_t qh = make(card::Queen, card::Hearts);
+        CHECK(card::value(qh) == 10 && card::value(make(card::Ace, card::Spades)) == 11);
+        CHECK(card::name(qh) == "QH");
+
+        CHECK(perfectPairsPayout(make(4, card::Spades), make(4, card::Spades)) == 25);
+        CHECK(perfectPairsPayout(make(4, card::Hearts), make(4, card::Diamonds)) == 12);
+        CHECK(perfectPairsPayout(make(4, card::Hearts), make(4, card::Clubs)) == 6);
+        CHECK(perfectPairsPayout(make(4, card::Hearts), make(5, card::Hearts)) == 0);
+
+        CHECK(twentyOnePlusThreePayout(make(7, 0), make(7, 0), make(7, 0)) == 100);
+        CHECK(twentyOnePlusThreePayout(make(7, 0), make(7, 1), make(7, 2)) == 30);
+        CHECK(twentyOnePlusThreePayout(make(card::Queen, 2), make(card::Ace, 2), make(card::King, 2)) == 40);
+        CHECK(twentyOnePlusThreePayout(make(card::Ace, 0), make(1, 2), make(2, 3)) == 10);   // A-2-3
+        CHECK(twentyOnePlusThreePayout(make(card::Ace, 3), make(5, 3), make(9, 3)) == 5);
+        CHECK(twentyOnePlusThreePayout(make(card::King, 0), make(card::Ace, 1), make(1, 2)) == 0);  // K-A-2 wraps
+
+        const uint8_t ace = make(card::Ace, card::Clubs), ten = make(card::Ten, card::Clubs);
+        CHECK(luckyLadiesPayout(qh, qh, ace, ten) == 1000);
+        CHECK(luckyLadiesPayout(qh, qh, ten, ten) == 125);
+        CHECK(luckyLadiesPayout(make(card::King, 0), make(card::King, 0), ten, ten) == 19);
+        CHECK(luckyLadiesPayout(make(card::King, 0), make(card::Jack, 0), ten, ten) == 9);
+        CHECK(luckyLadiesPayout(ace, make(8, card::Hearts), ten, ten) == 4);             // A+9
+        CHECK(luckyLadiesPayout(ace, ten, ten, ten) == 0);
+
+        // the shoe still deals every value the old way, now with suits
+        Deck sb(9u, 2);
+        auto values = sb.viewDeck();
+        CHECK(values.size() == 104);
+        CHECK(count(values.begin(), values.end(), 10) == 32);
+
+        const SideBetEdge exact = exactSideBets(6);
+        CHECK(exact.houseEdge(PerfectPairs) > 0.0 && exact.houseEdge(PerfectPairs) < 0.1);
+        CHECK(exact.houseEdge(TwentyOnePlusThree) > 0.0 && exact.houseEdge(TwentyOnePlusThree) < 0.1);
+        const SideBetEdge sim = simulateSideBets(3u, 6, 400000, 2);
+        CHECK(sim.hands == 400000);
+        CHECK(fabs(sim.houseEdge(PerfectPairs) - exact.houseEdge(PerfectPairs)) < 0.02);
+        CHECK(fabs(sim.houseEdge(TwentyOnePlusThree) - exact.houseEdge(TwentyOnePlusThree)) < 0.02);
+    }
+
+    section("Paired simulation");
+    {
+        Deck ld1(21u, 2), ld2(21u, 2), ld3(21u, 2);
+        ld1.loadShoe(7);
+        ld2.loadShoe(7);
+        ld3.loadShoe(7, true);
+        CHECK(ld1.viewDeck() == ld2.viewDeck());
+        CHECK(ld1.shuffleCount() == 7);
+        {
+            // mirrored twin: same composition, card-by-card opposite Hi-Lo tag
+            const vector<uint8_t>& plain = ld1.shoeCards();
+            const vector<uint8_t>& twin = ld3.shoeCards();
+            vector<uint8_t> sorted1(plain), sorted3(twin);
+            sort(sorted1.begin(), sorted1.end());
+            sort(sorted3.begin(), sorted3.end());
+            CHECK(sorted1 == sorted3);
+            auto hiLo = [](uint8_t c) { const int v = card::value(c); return v <= 6 ? 1 : v >= 10 ? -1 : 0; };
+            bool flipped = plain.size() == twin.size();
+            for (size_t i = 0; flipped && i < plain.size(); ++i) {
+                flipped = hiLo(twin[i]) == -hiLo(plain[i]) && card::suit(twin[i]) == card::suit(plain[i]);
+            }
+            CHECK(flipped);
+            CHECK(card::mirror(card::mirror(plain.back())) == plain.back());
+        }
+
+        PairedSimConfig same;
+        same.shoes = 40;
+        same.threads = 2;
+        const PairedSimResult r0 = runPairedSimulation(same);
+        CHECK(r0.a.n == 40 && r0.rounds > 0);
+        CHECK(r0.diff.sumSq == 0.0);               // identical rules, identical shoes
+
+        PairedSimConfig cmp = same;
+        cmp.b.hitSoft17 = true;
+        cmp.shoes = 400;
+        const PairedSimResult r1 = runPairedSimulation(cmp);
+        cmp.threads = 3;
+        const PairedSimResult r2 = runPairedSimulation(cmp);
+        CHECK(fabs(r1.diff.sum - r2.diff.sum) < 1e-9);   // thread count doesn't matter
+        CHECK(r1.varianceReduction() > 2.0);
+        CHECK(r1.aPlain.n == 0);
+        cmp.antithetic = true;
+        const PairedSimResult r3 = runPairedSimulation(cmp);
+        CHECK(r3.rounds == 2 * r1.rounds);
+        CHECK(r3.aPlain.n == 400 && fabs(r3.aPlain.sum - r1.a.sum) < 1e-9);   // plain half = the plain run
+        CHECK(r3.antitheticEdgeGain() > 0.0 && r3.antitheticDiffGain() > 0.0);
+    }
+
+    section("Risk of ruin");
+    {
+        // gambler's ruin: +1 w.p. .55, -1 w.p. .45, start 10, stop at 20
+        OutcomeDistribution walk;
+        walk.add(1, 55);
+        walk.add(-1, 45);
+        CHECK(walk.values.size() == 2 && fabs(walk.mean() - 0.1) < 1e-12);
+        const double r = 0.45 / 0.55;
+        const double exact = 1.0 - (1.0 - pow(r, 10)) / (1.0 - pow(r, 20));
+
+        RuinConfig rc;
+        rc.bankroll = 10;
+        rc.winGoal = 20;
+        rc.horizon = 1000000;
+        rc.paths = 40000;
+        rc.threads = 2;
+        rc.importance = false;
+        const RuinResult mc = estimateRuin(walk, rc);
+        rc.importance = true;
+        const RuinResult is = estimateRuin(walk, rc);
+        CHECK(mc.paths == 40000 && is.paths == 40000);
+        CHECK(fabs(mc.probability - exact) < 4 * mc.stdError);
+        CHECK(fabs(is.probability - exact) < 4 * is.stdError);
+        CHECK(is.tilt < 0.0 && is.stdError < mc.stdError);
+
+        rc.bankroll = 50;
+        rc.winGoal = 0;
+        rc.horizon = 40;                            // can't lose 50 in 40 rounds
+        CHECK(estimateRuin(walk, rc).probability == 0.0);
+    }
+
+    section("Bet ramp");
+    {
+        CHECK(CountOutcomes::bucket(-9.0) == 0);
+        CHECK(CountOutcomes::bucket(2.7) == static_cast<size_t>(2 - CountOutcomes::kMinCount));
+        const CountOutcomes sampled = sampleCountOutcomes(RuleSet(), 4u, 6, 60, 2);
+        CHECK(sampled.rounds() == 60LL * 39);
+
+        // synthetic counts: common and losing at TC <= 1, rare and winning above
+        CountOutcomes co;
+        for (int tc = CountOutcomes::kMinCount; tc <= CountOutcomes::kMaxCount; ++tc) {
+            const long long win = tc <= 1 ? 480 : 52 + tc;
+            const long long all = tc <= 1 ? 1000 : 100;
+            co.byCount[tc - CountOutcomes::kMinCount].add(1, win);
+            co.byCount[tc - CountOutcomes::kMinCount].add(-1, all - win);
+        }
+        BetRamp flat;
+        CHECK(flat.describe() == "1x@all");
+        const RampResult flatR = evaluateRamp(co, flat, 1000);
+        CHECK(fabs(flatR.averageBet - 1.0) < 1e-9 && flatR.ev < 0.0);
+
+        RampSearch rs;
+        rs.maxSpread = 8;
+        rs.ruinPaths = 2000;
+        rs.topWithRuin = 1;
+        rs.threads = 2;
+        const vector<RampResult> ramps = optimizeRamp(co, rs);
+        CHECK(ramps.size() > 10);
+        CHECK(ramps[0].growth > flatR.growth && ramps[0].ev > 0.0);
+        CHECK(ramps[0].ramp.betAt(1) == 1 && ramps[0].ramp.betAt(CountOutcomes::kMaxCount) == 8);
+        CHECK(ramps[0].ruin.paths == 2000 && ramps[1].ruin.paths == 0);
+
+        // ruin estimates sample the configured rules and bet policy
+        RuinConfig game;
+        game.seed = 4u;
+        game.sampleShoes = 60;
+        game.threads = 2;
+        const OutcomeDistribution flatSteps = sampleRuinOutcomes(game);
+        CHECK(flatSteps.total == sampled.rounds());
+        game.rampBets = { 1, 1, 1, 1, 1, 2, 4, 8 };              // 1 unit at TC <= 0, then 2, 4, 8 at 3+
+        const OutcomeDistribution rampSteps = sampleRuinOutcomes(game);
+        BetRamp same;
+        for (int tc = 1; tc <= CountOutcomes::kMaxCount; ++tc) same.bets[tc - CountOutcomes::kMinCount] = tc >= 3 ? 8 : 1 << tc;
+        const OutcomeDistribution direct = rampOutcomes(sampled, same);
+        CHECK(rampSteps.total == direct.total && rampSteps.values == direct.values && rampSteps.mean() == direct.mean());
+        game.rampBets.clear();
+        game.rules.hitSoft17 = true;
+        CHECK(sampleRuinOutcomes(game).mean() != flatSteps.mean());
+    }
+
+    section("Deviation indices");
+    {
+        Deck stack(1u, 1);
+        stack.loadCards({ card::make(4, 0), card::make(card::King, 1) });
+        CHECK(stack.deal() == 10 && stack.deal() == 5 && stack.cardsRemaining() == 0);
+
+        const string statePath = "test_deviation.state";
+        remove(statePath.c_str());
+        DeviationConfig dc;
+        dc.seed = 8u;
+        dc.shoes = 12;
+        dc.batchShoes = 6;
+        dc.threads = 2;
+        const DeviationTable fresh = generateDeviationIndices(dc);
+        CHECK(fresh.shoesDone == 12 && fresh.cells.size() == 50);
+        CHECK(fresh.cell(16, 10).total == 16 && fresh.cell(16, 10).dealerUp == 10);
+
+        dc.statePath = statePath;
+        dc.shoes = 6;
+        CHECK(generateDeviationIndices(dc).shoesDone == 6);
+        dc.shoes = 12;                              // resumes at shoe 7
+        dc.threads = 3;
+        const DeviationTable resumed = generateDeviationIndices(dc);
+        CHECK(resumed.shoesDone == 12);
+        bool same = true;
+        for (size_t c = 0; c < fresh.cells.size(); ++c)
+            for (size_t b = 0; b < fresh.cells[c].byCount.size(); ++b)
+                same = same && fresh.cells[c].byCount[b].n == resumed.cells[c].byCount[b].n
+                            && fresh.cells[c].byCount[b].sum == resumed.cells[c].byCount[b].sum;
+        CHECK(same);
+        remove(statePath.c_str());
+
+        // a cell whose hit advantage falls 0.1 per count, crossing at +2
+        DeviationCell line;
+        for (int tc = -4; tc <= 8; ++tc) {
+            RunningStat& st = line.byCount[tc - DeviationCell::kMinCount];
+            for (int i = 0; i < 500; ++i) st.add(0.1 * (2 - tc) + (i % 2 ? 1.0 : -1.0));
+        }
+        line.fitIndex();
+        CHECK(line.found && fabs(line.index - 2.0) < 1e-6);
+        CHECK(line.low < 2.0 && line.high > 2.0);
+    }
+
+    section("Checkpoint and resume");
+    {
+        const string path = "test_sim.checkpoint";
+        remove(path.c_str());
+        Checkpoint out;
+        out.write(42LL);
+        out.write(vector<double>{ 0.1, -2.5 });
+        CHECK(out.save(path, CheckpointPairedSim, 7u, 99));
+        Checkpoint in;
+        long long progress = 0;
+        CHECK(!in.load(path, CheckpointOutcomes, 7u, progress));    // other kind
+        CHECK(!in.load(path, CheckpointPairedSim, 8u, progress));   // other settings
+        CHECK(in.load(path, CheckpointPairedSim, 7u, progress) && progress == 99);
+        long long v = 0;
+        vector<double> xs;
+        CHECK(in.read(v) && in.read(xs) && in.atEnd() && v == 42 && xs.size() == 2 && xs[0] == 0.1);
+        CHECK(!in.read(v));
+        if (FILE* torn = fopen(path.c_str(), "r+b")) {             // flip a payload byte
+            fseek(torn, 40, SEEK_SET);
+            fputc(0x5A, torn);
+            fclose(torn);
+        }
+        CHECK(!in.load(path, CheckpointPairedSim, 7u, progress));
+        remove(path.c_str());
+
+        // a run stopped after 24 shoes and resumed to 40 = one uninterrupted run
+        PairedSimConfig pc;
+        pc.b.hitSoft17 = true;
+        pc.shoes = 40;
+        pc.batchShoes = 8;
+        pc.threads = 2;
+        const PairedSimResult whole = runPairedSimulation(pc);
+        pc.checkpoint.path = path;
+        pc.checkpoint.everySeconds = 3600.0;        // only the final save
+        pc.shoes = 24;
+        CHECK(runPairedSimulation(pc).checkpoint.saves == 1);
+        pc.shoes = 40;
+        pc.threads = 3;
+        const PairedSimResult resumed = runPairedSimulation(pc);
+        CHECK(resumed.checkpoint.resumedAt == 24 && resumed.a.n == 40 && resumed.rounds == whole.rounds);
+        CHECK(resumed.a.sum == whole.a.sum && resumed.diff.sumSq == whole.diff.sumSq);
+
+        // a shorter run can't resume a longer checkpoint: it starts over and
+        // leaves the file alone
+        pc.shoes = 16;
+        const PairedSimResult shorter = runPairedSimulation(pc);
+        CHECK(shorter.checkpoint.aheadAt == 40 && shorter.checkpoint.resumedAt == 0);
+        CHECK(shorter.a.n == 16 && shorter.checkpoint.saves == 0);
+        pc.shoes = 40;
+        CHECK(runPairedSimulation(pc).checkpoint.resumedAt == 40);
+        remove(path.c_str());
+
+        CheckpointConfig cc;
+        cc.path = path;
+        const CountOutcomes part = sampleCountOutcomes(RuleSet(), 4u, 6, 30, 2, cc);
+        const CountOutcomes rest = sampleCountOutcomes(RuleSet(), 4u, 6, 60, 2, cc);
+        const CountOutcomes full = sampleCountOutcomes(RuleSet(), 4u, 6, 60, 2);
+        CHECK(part.rounds() == 30LL * 39 && rest.rounds() == full.rounds());
+        CHECK(rest.at(2).counts == full.at(2).counts);
+        remove(path.c_str());
+    }
+
+    section("Quantile sketches");
+    {
+        vector<double> xs(20000);
+        for (size_t i = 0; i < xs.size(); ++i) xs[i] = static_cast<double>(i);
+        shuffle(xs.begin(), xs.end(), mt19937(5));
+        QuantileSketch whole, parts[4];
+        for (size_t i = 0; i < xs.size(); ++i) {
+            whole.add(xs[i]);
+            parts[i % 4].add(xs[i]);
+        }
+        QuantileSketch merged;
+        for (const QuantileSketch& p : parts) merged.merge(p);
+        CHECK(whole.count() == 20000 && merged.count() == 20000);
+        CHECK(whole.min() == 0.0 && whole.max() == 19999.0 && whole.quantile(1.0) == 19999.0);
+        CHECK(whole.retained() < 1000 && merged.retained() < 1000);   // bounded, not 20000
+        bool close = true;
+        for (double q : { 0.01, 0.25, 0.5, 0.9, 0.99 }) {
+            close = close && fabs(whole.quantile(q) / 20000 - q) < 0.02 && fabs(merged.quantile(q) / 20000 - q) < 0.02;
+        }
+        CHECK(close);
+        CHECK(fabs(merged.rank(5000.0) - 0.25) < 0.02);
+
+        // bankroll path: 100 -> 90 -> 80 -> 90 -> 110 -> 70
+        Player path("Path", 100);
+        path.setBet(10);
+        path.settleHand(0, -1);
+        path.settleHand(0, -1);
+        path.settleHand(0, 1);
+        path.handWon(20);
+        path.handLost(40);
+        CHECK(path.getPeakMoney() == 110 && path.getMaxDrawdown() == 40 && path.getHandsSettled() == 5);
+
+        SessionSimConfig sc;
+        sc.sessions = 60;
+        sc.bankroll = 50;
+        sc.bet = 10;
+        sc.maxRounds = 200;
+        sc.shards = 6;
+        sc.threads = 2;
+        const SessionSketches a = simulateSessions(sc);
+        sc.threads = 3;
+        const SessionSketches b = simulateSessions(sc);
+        CHECK(a.sessions == 60 && a.endingBankroll.count() == 60 && a.ruined > 0);
+        CHECK(a.handsPlayed.max() <= 200 * Player::kMaxHands && a.maxDrawdown.min() >= 0);
+        CHECK(a.endingBankroll.quantile(0.5) == b.endingBankroll.quantile(0.5) && a.ruined == b.ruined);
+        // only broke sessions are timed, in rounds played
+        CHECK(a.roundsToRuin.count() == static_cast<uint64_t>(a.ruined));
+        CHECK(a.roundsToRuin.min() >= 1 && a.roundsToRuin.max() <= sc.maxRounds);
+        CHECK(a.roundsToRuin.quantile(0.5) == b.roundsToRuin.quantile(0.5));
+
+        SessionSketches one;
+        Player broke("sim", 10), capped("sim", 10);
+        broke.handLost(10);
+        one.record(broke, 1);
+        one.record(capped, 7);
+        CHECK(one.ruined == 1 && one.roundsToRuin.count() == 1 && one.roundsToRuin.max() == 1);
+    }
+
+    section("NUMA placement");
+    {
+        const numa::Topology& topo = numa::topology();
+        CHECK(!topo.nodes.empty() && topo.cpuCount() >= 1);
+        const vector<int> cpus = numa::placeWorkers(topo.cpuCount() + 3);
+        bool known = cpus.size() == topo.cpuCount() + 3;
+        for (int c : cpus) {
+            bool found = false;
+            for (const vector<int>& node : topo.nodes) found = found || find(node.begin(), node.end(), c) != node.end();
+            known = known && found;
+        }
+        CHECK(known);
+        CHECK(numa::placeWorkers(1, 1)[0] == topo.nodes[0][0]);
+
+        // every index runs once, on the CPU it was placed on; slots of
+        // finished threads still count
+        const size_t workers = 3;
+        const vector<int> placed = numa::placeWorkers(workers);
+        vector<int> ran(workers, -1);
+#if CLUB_STATS
+        const uint64_t dealtBefore = stats::snapshotStats().counters[stats::CardsDealt];
+#endif
+        numa::runPinned(workers, [&](size_t t) {
+            Deck mine(40u + static_cast<unsigned int>(t), 1);
+            for (int i = 0; i < 10; ++i) mine.deal();
+            ran[t] = numa::currentCpu();
+        });
+        CHECK(ran == placed || ran[0] == -1);
+#if CLUB_STATS
+        CHECK(stats::snapshotStats().counters[stats::CardsDealt] - dealtBefore == 30);
+
+        // batch after batch of fresh workers reuses the slots of the last one
+        const int slotsBefore = stats::slotCount();
+        for (int batch = 0; batch < 80; ++batch)
+            numa::runPinned(4, [](size_t) { CLUB_STAT_INC(CardsDealt); });
+        CHECK(stats::slotCount() <= slotsBefore + 4);
+        CHECK(stats::snapshotStats().counters[stats::CardsDealt] - dealtBefore == 30 + 320);
+#endif
+    }
+
+    section("Wallet ledger");
+    {
+        Wallet w(100);
+        CHECK(w.reserve(60, 1) && !w.reserve(50, 2));          // second would overdraw
+        CHECK(w.available() == 40 && w.reserved() == 60);
+        w.settle(60, 120, 1);                                   // won
+        w.deposit(5);
+        CHECK(w.reserve(30) && w.available() == 135);
+        w.release(30);
+        const vector<LedgerEntry> trail = w.audit();
+        CHECK(trail.size() == 7 && trail[2].kind == LedgerEntry::Refused && trail[3].payout == 120);
+        CHECK(w.balance() == 165 && checkTrail(trail, 165, 0) && !checkTrail(trail, 164, 0));
+
+        // two seats on one account
+        Wallet shared(30);
+        Player a("A", 0), b("B", 0);
+        a.attachWallet(&shared, 1);
+        b.attachWallet(&shared, 2);
+        a.setBet(10);
+        b.setBet(10);
+        CHECK(shared.reserved() == 20 && a.getMoney() == 20 && a.getBet() == 10);
+        a.cardDealt(5);
+        a.cardDealt(6);
+        b.cardDealt(5);
+        b.cardDealt(6);
+        CHECK(a.canDouble(0) && a.doubleHand(0) && a.betOn(0) == 20);
+        CHECK(shared.reserved() == 30 && shared.available() == 0 && !b.canDouble(0) && !b.doubleHand(0));
+        a.settleHand(0, 1);                                     // doubled win: +20
+        a.clearHand();                                          // next round's stake reserved again
+        CHECK(shared.available() == 30 && shared.reserved() == 20);
+        b.handLost(10);                                         // settles and reserves again too
+        CHECK(shared.available() == 20 && shared.reserved() == 20);
+        a.detachWallet();
+        b.detachWallet();
+        CHECK(shared.available() == 30 + 20 - 10 && shared.reserved() == 0 && a.getBet() == 0);
+        CHECK(checkTrail(shared.audit(), shared.available(), 0));
+
+        // four threads hammering one account: no lost updates
+        Wallet busy(1000);
+        numa::runPinned(4, [&](size_t t) {
+            for (int i = 0; i < 5000; ++i) {
+                if (busy.reserve(3, static_cast<uint32_t>(t))) busy.settle(3, (i % 2) ? 0 : 6, static_cast<uint32_t>(t));
+            }
+        });
+        CHECK(busy.available() == 1000 && busy.reserved() == 0 && busy.auditCount() == 1 + 4 * 10000);
+        CHECK(checkTrail(busy.audit(), 1000, 0));
+
+        // tables on their own threads, one seat each, one account
+        Wallet bank(300);
+        long long net[3] = {};
+        numa::runPinned(3, [&](size_t t) {
+            Deck d(60u + static_cast<unsigned int>(t), 6);
+            Table tb(d);
+            Player seat("W", 0);
+            seat.attachWallet(&bank, static_cast<uint32_t>(t));
+            seat.setBet(10);
+            tb.addPlayer(&seat);
+            BasicStrategy bs;
+            RoundResult rr[50];
+            const size_t n = tb.playRounds(50, bs, rr);
+            for (size_t i = 0; i < n; ++i) net[t] += rr[i].net;
+            seat.detachWallet();
+        });
+        CHECK(bank.reserved() == 0 && bank.available() == 300 + net[0] + net[1] + net[2]);
+        CHECK(checkTrail(bank.audit(), bank.available(), 0));
+    }
+
+    section("Hot-reloaded rules");
+    {
+        TableRules parsed;
+        string why;
+        CHECK(parseRules("# house\nhit_soft_17 = true\nmin_bet = 25 # floor\n\nmax_bet=500\n", parsed, &why));
+        CHECK(parsed.hitSoft17 && parsed.minBet == 25 && parsed.maxBet == 500 && parsed.maxPlayers == 4);
+        CHECK(!parseRules("min_bet = 5\nmax_bte = 9\n", parsed, &why) && why.find("line 2") == 0);
+        CHECK(!parseRules("min_bet = 50\nmax_bet = 10\n", parsed, &why) && !parseRules("max_players = 8", parsed));
+        CHECK(!parseRules("min_bet 5", parsed) && !parseRules("min_bet = 5x", parsed) && parsed.minBet == 25);
+
+        // readers keep their version until they refresh; old versions are
+        // freed once no reader can hold them
+        RuleConfig config;
+        RuleConfig::Reader reader(config);
+        CHECK(reader.get().version == 1 && !reader.refresh());
+        TableRules next;
+        next.maxBet = 5;
+        next.minBet = 2;
+        next.hitSoft17 = true;
+        CHECK(config.publish(next) == 2 && reader.get().version == 1 && config.pendingVersions() == 1);
+        CHECK(reader.refresh() && reader.get().maxBet == 5);
+        config.publish(next);
+        CHECK(config.pendingVersions() == 1);                   // v2 still held by the reader
+        reader.refresh();
+        config.publish(next);
+        CHECK(config.pendingVersions() == 1 && config.version() == 4);
+
+        // the table applies them between rounds
+        Deck rd(70u, 6);
+        Table rt(rd);
+        Player capped("Capped", 1000);
+        capped.setBet(10);
+        rt.addPlayer(&capped);
+        rt.setRules(&reader);
+        BasicStrategy bs;
+        RoundResult rr[5];
+        CHECK(rt.playRounds(5, bs, rr) == 5 && rt.getDealer().getHitSoft17());
+        bool fiveStakes = true, oddFive = false;                // $5 a hand (x2 doubled), not $10
+        for (const RoundResult& x : rr) {
+            fiveStakes = fiveStakes && x.net % 5 == 0 && abs(x.net) <= 10 * (x.wins + x.losses + x.pushes);
+            oddFive = oddFive || x.net % 10 != 0;
+        }
+        CHECK(fiveStakes && oddFive && capped.getBet() == 10);  // the seat's own bet is kept
+        next.minBet = 50;
+        next.maxBet = 100;
+        config.publish(next);
+        CHECK(rt.playRounds(5, bs, rr) == 0);                   // $10 seat is under the new minimum
+        next.minBet = 2;
+        next.maxBet = 1000;
+        config.publish(next);
+        CHECK(rt.playRounds(1, bs, rr) == 1 && rr[0].net % 10 == 0 && capped.getBet() == 10);
+        rt.setRules(nullptr);
+
+        // from a file
+        const string path = "test_rules.cfg";
+        auto writeRules = [&path](const char* text) {
+            if (FILE* f = fopen(path.c_str(), "wb")) {
+                fputs(text, f);
+                fclose(f);
+            }
+        };
+        writeRules("min_bet = 10\nmax_bet = 20\n");
+        CHECK(config.reloadIfChanged(path, &why) && !config.reloadIfChanged(path, &why));
+        writeRules("min_bet = ten\n");
+        why.clear();
+        CHECK(!config.reloadIfChanged(path, &why) && !why.empty() && config.snapshot().maxBet == 20);
+        remove(path.c_str());
+
+        // a writer racing three readers: every reader sees whole versions
+        std::atomic<bool> done{ false };
+        std::atomic<int> torn{ 0 };
+        numa::runPinned(4, [&](size_t t) {
+            if (t == 0) {
+                TableRules v;
+                for (int i = 1; i <= 300; ++i) {
+                    v.minBet = i;
+                    v.maxBet = 2 * i;
+                    config.publish(v);
+                }
+                done.store(true);
+                return;
+            }
+            RuleConfig::Reader mine(config);
+            while (!done.load()) {
+                mine.refresh();
+                if (mine.get().minBet * 2 != mine.get().maxBet) torn.fetch_add(1);
+            }
+        });
+        reader.refresh();
+        config.publish(next);
+        CHECK(torn.load() == 0 && config.snapshot().version == config.version() && config.pendingVersions() == 1);
+    }
+
+    section("Endgame solver");
+    {
+        EndgameSolver solver;
+        const uint8_t ten = card::make(card::King, 0), five = card::make(4, 1);
+        const EndgameResult tens = solver.solve({ ten, ten, ten }, { 10, 6 }, 10);
+        CHECK(tens.valid && tens.standEv == -1.0 && tens.hitEv == -1.0 && !tens.hit);
+        const EndgameResult fives = solver.solve(vector<uint8_t>(12, five), { 10, 6 }, 6);
+        CHECK(fives.valid && fives.hit);                // 16 -> 21, dealer 6+5+5+5 = 21
+        CHECK(fives.standEv == -1.0 && fives.hitEv == 0.0);
+        CHECK(!solver.solve({}, { 10, 6 }, 6).valid);
+        // several aces: A,A + 10 is a hard 12 (not a bust), dealer A x 7 is soft 17
+        const uint8_t ace = card::make(card::Ace, 0);
+        const EndgameResult aa = solver.solve(vector<uint8_t>(6, ten), { 11, 11 }, 6);
+        CHECK(aa.valid && aa.standEv == 1.0 && aa.hitEv == 1.0);   // 16 + 10 busts the dealer
+        const EndgameResult dealerAces = solver.solve(vector<uint8_t>(10, ace), { 10, 7 }, 11);
+        CHECK(dealerAces.valid && dealerAces.standEv == 0.0);     // 17 vs 17
+
+        // exact stand EV vs dealing the same 25 cards in random orders
+        Deck src(12u, 1);
+        src.loadShoe(1);
+        vector<uint8_t> unseen(src.shoeCards().begin(), src.shoeCards().begin() + 25);
+        const EndgameResult exact = solver.solve(unseen, { 10, 7 }, 10);
+        CHECK(exact.valid && solver.tableSize() > 0);
+        std::mt19937 rng(5);
+        Deck stacked(1u, 1);
+        Dealer d;
+        long long net = 0;
+        const int trials = 20000;
+        for (int i = 0; i < trials; ++i) {
+            shuffle(unseen.begin(), unseen.end(), rng);
+            stacked.loadCards(unseen);
+            d.clearHand();
+            d.cardDealt(10);
+            d.cardDealt(stacked.deal());
+            d.playHand(stacked);
+            const int dv = d.handValue();
+            net += (dv > 21 || 17 > dv) ? 1 : (17 < dv ? -1 : 0);
+        }
+        CHECK(fabs(static_cast<double>(net) / trials - exact.standEv) < 0.03);
+
+        // solveSeat adds the dealer's hole card to the unseen cards
+        Deck sd(3u, 1);
+        Table st(sd);
+        Player sp("Solver", 100);
+        sp.setBet(10);
+        st.addPlayer(&sp);
+        st.startRound();
+        const EndgameResult seat = solveSeat(solver, st, sp);
+        CHECK(seat.valid == (sp.handValue() <= 21));
+        st.clearHands();
+    }
+
+    section("Split and double");
+    {
+        Hand soft{ 11, 6 };
+        CHECK(soft.value() == 17 && soft.isSoft() && soft.size() == 2);
+        soft.add(10);
+        CHECK(soft.value() == 17 && !soft.isSoft());
+        CHECK(Hand({ 8, 8 }).isPair() && !Hand({ 8, 9 }).isPair());
+
+        // next card dealt is the back of the vector, so stack in reverse
+        auto stack = [](Deck& d, vector<int> values) {
+            vector<uint8_t> codes;
+            for (auto it = values.rbegin(); it != values.rend(); ++it)
+                codes.push_back(card::make(*it == 11 ? card::Ace : (*it == 10 ? card::Ten : *it - 1), card::Spades));
+            d.loadCards(codes);
+        };
+
+        // 8,8 vs 10 up / 7 hole: split, draw 3 and 10, double the 11 into 21
+        Deck sd(1u, 1);
+        stack(sd, { 8, 10, 8, 7, 3, 10, 10 });
+        Table st(sd);
+        Player sp("Splitter", 100);
+        sp.setBet(10);
+        st.addPlayer(&sp);
+        st.startRound();
+        CHECK(sp.canSplit(0) && sp.canDouble(0));
+        CHECK(st.playerSplit(sp, 0) == 1);
+        CHECK(sp.handCount() == 2 && sp.handAt(0).value() == 11 && sp.handAt(1).value() == 18);
+        CHECK(st.playerDouble(sp, 0) && sp.betOn(0) == 20 && sp.isHandLocked(0));
+        st.playerHit(sp, 0);                        // doubled: refused
+        CHECK(sp.handAt(0).size() == 3 && sp.handAt(0).value() == 21);
+        CHECK(sp.committedBets() == 30);
+        st.dealerPlay();
+        st.settleBets();
+        CHECK(sp.getMoney() == 130 && sp.getWins() == 2);
+        CHECK(sp.handCount() == 1 && sp.getHand().empty() && sp.betOn(0) == 10);
+
+        // split aces get one card each; no split/double without money to cover it
+        Deck ad(1u, 1);
+        stack(ad, { 11, 10, 11, 9, 2, 5 });
+        Table at(ad);
+        Player aces("Aces", 100), poor("Poor", 15);
+        aces.setBet(10);
+        at.addPlayer(&aces);
+        at.startRound();
+        CHECK(at.playerSplit(aces, 0) == 1 && aces.isHandLocked(0) && aces.isHandLocked(1));
+        at.playerHit(aces, 1);
+        CHECK(aces.handAt(1).size() == 2 && aces.handAt(1).value() == 16);
+        at.clearHands();
+        poor.setBet(10);
+        poor.cardDealt(11); poor.cardDealt(11);
+        CHECK(!poor.canSplit(0) && !poor.canDouble(0));
+
+        // policies: basic splits 8s (up to four hands), hit-below never does
+        HandContext ctx;
+        ctx.pairCard = 8; ctx.dealerUp = 10; ctx.canSplit = true;
+        BasicStrategy basic;
+        BotStrategy hitter = HitBelow{ 17 };
+        CHECK(decideSplit(basic, ctx) && !decideSplit(hitter, ctx));
+        ctx.canSplit = false;
+        CHECK(!decideSplit(basic, ctx));
+        ctx.total = 11; ctx.pairCard = 0; ctx.canDouble = true;
+        CHECK(decideDouble(basic, ctx) && !decideDouble(hitter, ctx));
+
+        Deck ed(1u, 1);
+        stack(ed, vector<int>(20, 8));
+        Table et(ed);
+        Player bot("Bot", 1000);
+        bot.setBet(10);
+        et.addPlayer(&bot);
+        et.startRound();
+        playBotTurn(basic, bot, et);
+        CHECK(bot.handCount() == Player::kMaxHands && bot.committedBets() == 40);
+        et.clearHands();
+    }
+
+    section("Frame renderer");
+    {
+        FILE* sink = tmpfile();
+        FrameBuffer fb(sink);
+        {
+            ostream os(&fb);
+            os << "line one" << endl << "line two" << endl;
+        }
+        CHECK(fb.presents() == 0 && ftell(sink) == 0);   // endl doesn't write
+        fb.present();
+        fb.present();                                   // nothing pending: no write
+        CHECK(fb.presents() == 1 && ftell(sink) == 18 && fb.pending().empty());
+        fclose(sink);
+
+        ScreenDiff screen(2);
+        screen.setRegion(0, { "Table 1", "  Seat1 $100" });
+        screen.setRegion(1, { "Table 2", "  Seat1 $200" });
+        string first;
+        screen.compose(first);
+        CHECK(first.find("Table 2") != string::npos && screen.rowsWritten() == 4);
+
+        screen.setRegion(1, { "Table 2", "  Seat1 $210" });
+        string next;
+        screen.compose(next);
+        CHECK(screen.rowsWritten() == 5);               // only the changed row
+        CHECK(next.find("\x1b[4;1H  Seat1 $210") != string::npos && next.find("Table") == string::npos);
+
+        ScreenDiff fullScreen(2, false);
+        fullScreen.setRegion(0, { "a", "b" });
+        string s1, s2;
+        fullScreen.compose(s1);
+        fullScreen.compose(s2);
+        CHECK(fullScreen.rowsWritten() == 4);
+    }
+
+    section("Load generator");
+    {
+        LoadConfig lc;
+        lc.seatsPerTable = 3;
+        lc.stepSeconds = 0.3;
+        lc.thinkScale = 0.001;                          // ~1.5 ms decisions
+        lc.workers = 2;
+        const LoadStep step = runLoadStep(lc, 7);       // tables of 3, 3 and 1
+        CHECK(step.sessions == 7 && step.requests > 100);
+        CHECK(step.latency.count() == step.requests && step.seconds > 0.1);
+
+        lc.startSessions = 2;
+        lc.maxSessions = 8;
+        lc.stepSeconds = 0.15;
+        lc.p99TargetUs = 1e9;                           // can't miss
+        const LoadResult easy = runLoadRamp(lc);
+        CHECK(easy.maxSustainable == 8 && easy.steps.size() == 3);   // 2, 4, 8
+        lc.p99TargetUs = 1e-3;                          // can't pass
+        const LoadResult hard = runLoadRamp(lc);
+        CHECK(hard.maxSustainable == 0 && hard.steps.size() == 1);
+    }
+
+    section("Spectator feed");
+    {
+        SpectatorFeed feed, viewer;
+        CHECK(!viewer.attach("club_paradise_test_feed"));
+        CHECK(feed.create("club_paradise_test_feed", 3) && feed.capacity() == 4);
+        CHECK(viewer.attach("club_paradise_test_feed") && viewer.head() == 0);
+        {
+            SpectatorFeed rival;                     // the name belongs to a live table
+            CHECK(!rival.create("club_paradise_test_feed"));
+        }
+        CHECK(viewer.attach("club_paradise_test_feed"));   // and a failed rival leaves it alone
+
+        // player 10,7 stands on 17; dealer 10 up, 9 hole
+        Deck fd(1u, 1);
+        fd.loadCards(vector<uint8_t>{ card::make(8, card::Spades), card::make(6, card::Spades),
+            card::make(card::Ten, card::Spades), card::make(card::Ten, card::Hearts) });
+        Table ft(fd);
+        ft.setQuiet(true);
+        ft.setSpectatorFeed(&feed, 7);
+        Player fp("Watched", 100);
+        fp.setBet(10);
+        ft.addPlayer(&fp);
+        ft.startRound();
+        ft.playerStand(fp);
+        ft.dealerPlay();
+        ft.settleBets();
+        CHECK(viewer.head() == 4);                  // deal, stand, dealer, settle
+
+        SpectatorFrame f;
+        CHECK(viewer.read(0, f) && f.event == SpectatorFrame::Deal && f.tableId == 7 && f.round == 1);
+        CHECK(f.dealerCardCount == 1 && f.dealerValue == 10 && f.seatCount == 1);
+        CHECK(f.seats[0].handCount == 1 && f.seats[0].hands[0].value == 17 && f.seats[0].hands[0].bet == 10);
+        CHECK(viewer.read(2, f) && f.event == SpectatorFrame::Dealer && f.dealerCardCount == 2 && f.dealerValue == 19);
+        CHECK(viewer.read(3, f) && f.event == SpectatorFrame::Settle);
+        CHECK(f.seats[0].hands[0].result == -1 && f.seats[0].money == 90 && f.seats[0].hands[0].cardCount == 2);
+        CHECK(!viewer.read(4, f));                  // not published yet
+
+        // a reader that falls a lap behind finds out from the slot sequence
+        for (uint32_t r = 0; r < 6; ++r) {
+            f.round = 100 + r;
+            feed.publish(f);
+        }
+        CHECK(viewer.head() == 10 && !viewer.read(5, f));
+        uint32_t seen = 0;
+        CHECK(viewer.visit(9, [&](const SpectatorFrame& live) { seen = live.round; }) && seen == 105);
+
+        viewer.close();
+        feed.close();
+        CHECK(!viewer.attach("club_paradise_test_feed"));   // owner removed the segment
+    }
+
     // -------------------------------------------------
     // Summary
     // -------------------------------------------------
@@ -0,0 +1,163 @@
+/*
+ * NUMA Placement Implementation
+ * -----------------------------
+ * Linux reads the node CPU lists from sysfs ("0-15,32-47") and keeps only
+ * the CPUs in the process affinity mask (taskset, cgroups). Windows walks
+ * the nodes with GetNumaNodeProcessorMaskEx; CPU ids there are
+ * group * 64 + bit, the same numbering pinToCpu expects.
+ */
+
+#include "numa.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace std;
+
+namespace numa {
+
+namespace {
+
+#ifndef _WIN32
+// "0-3,8,10-11" -> {0,1,2,3,8,10,11}
+vector<int> parseCpuList(const string& text) {
+    vector<int> cpus;
+    stringstream in(text);
+    string part;
+    while (getline(in, part, ',')) {
+        if (part.empty() || part == "\n") continue;
+        const size_t dash = part.find('-');
+        try {
+            const int first = stoi(part.substr(0, dash));
+            const int last = dash == string::npos ? first : stoi(part.substr(dash + 1));
+            for (int c = first; c <= last; ++c) cpus.push_back(c);
+        }
+        catch (...) {
+            return {};
+        }
+    }
+    return cpus;
+}
+#endif
+
+Topology detect() {
+    Topology t;
+#ifdef _WIN32
+    ULONG highest = 0;
+    if (GetNumaHighestNodeNumber(&highest)) {
+        for (USHORT node = 0; node <= highest; ++node) {
+            GROUP_AFFINITY mask = {};
+            if (!GetNumaNodeProcessorMaskEx(node, &mask)) continue;
+            vector<int> cpus;
+            for (int bit = 0; bit < 64; ++bit)
+                if (mask.Mask & (KAFFINITY(1) << bit)) cpus.push_back(mask.Group * 64 + bit);
+            if (!cpus.empty()) t.nodes.push_back(cpus);
+        }
+    }
+#else
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    const bool haveMask = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+    for (int node = 0; node < 1024; ++node) {
+        ifstream list("/sys/devices/system/node/node" + to_string(node) + "/cpulist");
+        if (!list) break;                               // node ids are dense in practice
+        string text;
+        getline(list, text);
+        vector<int> cpus;
+        for (int c : parseCpuList(text))
+            if (!haveMask || (c < CPU_SETSIZE && CPU_ISSET(c, &allowed))) cpus.push_back(c);
+        if (!cpus.empty()) t.nodes.push_back(cpus);
+    }
+#endif
+    if (t.nodes.empty()) {
+        const int n = static_cast<int>(max(1u, thread::hardware_concurrency()));
+        vector<int> cpus(static_cast<size_t>(n));
+        for (int c = 0; c < n; ++c) cpus[static_cast<size_t>(c)] = c;
+        t.nodes.push_back(cpus);
+    }
+    return t;
+}
+
+} // namespace
+
+size_t Topology::cpuCount() const {
+    size_t n = 0;
+    for (const vector<int>& cpus : nodes) n += cpus.size();
+    return n;
+}
+
+const Topology& topology() {
+    static const Topology t = detect();
+    return t;
+}
+
+/**
+ * placeWorkers(workers, nodes)
+ * ----------------------------
+ * Worker i goes to node i % nodes, taking that node's CPUs in order; with
+ * more workers than CPUs the placement wraps around.
+ */
+vector<int> placeWorkers(size_t workers, size_t nodes) {
+    const Topology& t = topology();
+    const size_t used = nodes == 0 ? t.nodes.size() : min(nodes, t.nodes.size());
+    vector<size_t> next(used, 0);
+    vector<int> cpus;
+    cpus.reserve(workers);
+    for (size_t i = 0; i < workers; ++i) {
+        const size_t node = i % used;
+        const vector<int>& list = t.nodes[node];
+        cpus.push_back(list[next[node]++ % list.size()]);
+    }
+    return cpus;
+}
+
+bool pinToCpu(int cpu) {
+    if (cpu < 0) return false;
+#ifdef _WIN32
+    GROUP_AFFINITY mask = {};
+    mask.Group = static_cast<WORD>(cpu / 64);
+    mask.Mask = KAFFINITY(1) << (cpu % 64);
+    return SetThreadGroupAffinity(GetCurrentThread(), &mask, nullptr) != 0;
+#else
+    if (cpu >= CPU_SETSIZE) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#endif
+}
+
+int currentCpu() {
+#ifdef _WIN32
+    PROCESSOR_NUMBER p;
+    GetCurrentProcessorNumberEx(&p);
+    return p.Group * 64 + p.Number;
+#else
+    return sched_getcpu();
+#endif
+}
+
+void runPinned(size_t workers, const function<void(size_t)>& fn, size_t nodes) {
+    const vector<int> cpus = placeWorkers(workers, nodes);
+    vector<thread> pool;
+    pool.reserve(workers);
+    for (size_t t = 0; t < workers; ++t) {
+        pool.emplace_back([&fn, &cpus, t]() {
+            pinToCpu(cpus[t]);
+            fn(t);
+        });
+    }
+    for (thread& w : pool) w.join();
+}
+
+} // namespace numa
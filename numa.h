@@ -0,0 +1,43 @@
+#ifndef NUMA_H
+#define NUMA_H
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+/**
+ * NUMA placement for simulation workers
+ * - topology(): the NUMA nodes and the CPUs of each that this process may
+ *   run on (Linux: /sys/devices/system/node + the affinity mask; Windows:
+ *   GetNumaNodeProcessorMaskEx). One node holding every CPU when the
+ *   machine doesn't say.
+ * - Memory follows first touch on both systems: a page lands on the node
+ *   of the thread that first writes it. So a worker that is pinned before
+ *   it builds its Decks, Tables and players gets all of them node-local,
+ *   with no allocator changes.
+ * - runPinned(n, fn) runs fn(0..n-1) on n threads, each pinned to one CPU
+ *   before fn starts. Workers are spread over the nodes round-robin (or
+ *   packed onto the first `nodes` nodes), one per CPU until the CPUs run
+ *   out.
+ */
+namespace numa {
+
+struct Topology {
+    std::vector<std::vector<int>> nodes;    // CPU ids per node
+
+    size_t cpuCount() const;
+};
+
+const Topology& topology();
+
+// CPU for each of `workers` workers, using the first `nodes` nodes (0 = all).
+std::vector<int> placeWorkers(size_t workers, size_t nodes = 0);
+
+bool pinToCpu(int cpu);                     // the calling thread; false if refused
+int currentCpu();                           // -1 if unknown
+
+void runPinned(size_t workers, const std::function<void(size_t)>& fn, size_t nodes = 0);
+
+} // namespace numa
+
+#endif // NUMA_H
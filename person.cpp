@@ -4,25 +4,19 @@
 #include "person.h"
 #include <iostream>
 
-//adds card to hand and checks if card is an ace
+//adds card to hand (the hand keeps its running total and ace count)
 void Person::cardDealt(int card) {
-    if (card == 11) {
-        ace = true;
-    }
-    hand.push_back(card);
+    hand.add(card);
 };
-//returns hand value
+//returns hand value: while it is over 21, aces drop from 11 to 1 one at a time
 int Person::handValue() const {
-    int value = 0;
-    for (int i : hand) {
-        value += i;
-    };
-    //if hand value is > 21 and ace == true this subtracts 10 from value
-    if (value > 21 && ace == true) {
-        value = value - 10;
-    }
-    return value;
+    return hand.value();
 };
+//returns true if the hand is "soft": an Ace still counts as 11 without busting
+//e.g. A+6 = soft 17, A+6+10 = hard 17
+bool Person::isSoft() const {
+    return hand.isSoft();
+}
 //prints cards held as so [1, 2, 3, }
 void Person::showHand() const {
     cout << "[";
@@ -31,9 +25,8 @@ void Person::showHand() const {
     };
     cout << "]";
 };
-//clears hand vector of all cards
+//clears hand of all cards
 void Person::clearHand() {
     hand.clear();
-    ace = false;
     return;
 }
@@ -4,18 +4,20 @@
 #ifndef PERSON_H
 #define PERSON_H
 #include <vector>
+#include "hand.h"
 using namespace std;
 
 class Person {
 protected:
-    vector<int> hand;
-    bool ace = false;
+    Hand hand;//inline card storage, see hand.h
 public:
     virtual ~Person() {}
     void cardDealt(int card);
     int handValue() const; 
+    bool isSoft() const;   // true if an Ace is still counted as 11
     void showHand() const;
     void clearHand();
+    const Hand& getHand() const { return hand; }
 };
 
 #endif // PERSON_H
@@ -1,17 +1,74 @@
 #include "player.h"
+#include "wallet.h"
+#include <algorithm>
 #include <iostream>
 using namespace std;
 
 Player::Player(string inName, int inMoney)
-    : name(std::move(inName)), money(inMoney), startingMoney(inMoney), bet(0) {
+    : name(std::move(inName)), money(inMoney), startingMoney(inMoney), bet(0), peakMoney(inMoney) {
 }
 
 void Player::setBet(int betAmount) {
-    if (betAmount > money) {
+    if (wallet) {
+        // between rounds only the current bet is reserved; adjust it to the new one
+        const int change = betAmount - reservedHere;
+        if (change > 0 && !wallet->reserve(change, walletTable)) {
+            cout << "Bet can't be greater than your current bank amount: $" << getMoney() << endl;
+            return;
+        }
+        if (change < 0) wallet->release(-change, walletTable);
+        reservedHere = betAmount;
+    }
+    else if (betAmount > money) {
         cout << "Bet can't be greater than your current bank amount: $" << money << endl;
         return;
     }
     bet = betAmount;
+    handBets[0] = bet;
+}
+
+void Player::attachWallet(Wallet* w, uint32_t tableId) {
+    detachWallet();
+    if (!w) return;
+    wallet = w;
+    walletTable = tableId;
+    reservedHere = 0;
+    handBets[0] = 0;          // the standing bet is reserved when a round covers it
+    startingMoney = peakMoney = getMoney();
+}
+
+void Player::detachWallet() {
+    if (!wallet) return;
+    wallet->release(reservedHere, walletTable);
+    wallet = nullptr;
+    reservedHere = 0;
+    money = 0;                // the money stays in the account
+    bet = 0;
+    handBets[0] = 0;
+}
+
+//tops the reservation up (or down) to this round's stake (the standing bet,
+//capped); a short account plays what is already reserved, possibly nothing
+bool Player::coverBet(int cap) {
+    const int stake = min(bet, cap);
+    if (!wallet) {
+        handBets[0] = stake;
+        return stake > 0;
+    }
+    if (reservedHere < stake && wallet->reserve(stake - reservedHere, walletTable)) reservedHere = stake;
+    else if (reservedHere > stake) {
+        wallet->release(reservedHere - stake, walletTable);
+        reservedHere = stake;
+    }
+    handBets[0] = reservedHere;
+    return reservedHere > 0;
+}
+
+bool Player::reserveExtra(int amount) {
+    if (!wallet) return true;
+    if (!wallet->reserve(amount, walletTable)) return false;
+    reservedHere += amount;
+    return true;
 }
 
 int Player::getBet() const {
@@ -19,23 +76,36 @@ int Player::getBet() const {
 }
 
 void Player::handWon(int moneyWon) {
+    if (wallet) {
+        wallet->settle(reservedHere, reservedHere + moneyWon, walletTable);
+        reservedHere = 0;
+    }
     money += moneyWon;
     ++wins;
+    notePath();
     clearHand();
-    ace = false;
 }
 
 void Player::handLost(int moneyLost) {
+    if (wallet) {
+        // a loss can take no more than the reserved stake
+        wallet->settle(reservedHere, max(reservedHere - moneyLost, 0), walletTable);
+        reservedHere = 0;
+    }
     money -= moneyLost;
     ++losses;
+    notePath();
     clearHand();
-    ace = false;
 }
 
 void Player::handPush() {
+    if (wallet) {
+        wallet->settle(reservedHere, reservedHere, walletTable);
+        reservedHere = 0;
+    }
     ++pushes;
+    notePath();
     clearHand();
-    ace = false;
 }
 
 const string& Player::getName() const {
@@ -43,5 +113,72 @@ const string& Player::getName() const {
 }
 
 int Player::getMoney() const {
-    return money;
+    return wallet ? wallet->available() + reservedHere : money;
+}
+
+int Player::committedBets() const {
+    int total = 0;
+    for (int i = 0; i < hands; ++i) total += handBets[i];
+    return total;
+}
+
+bool Player::canSplit(int i) const {
+    return hands < kMaxHands && !isHandLocked(i) && handAt(i).isPair()
+        && (wallet ? handBets[i] <= wallet->available() : committedBets() + handBets[i] <= money);
+}
+
+bool Player::canDouble(int i) const {
+    return !isHandLocked(i) && handAt(i).size() == 2
+        && (wallet ? handBets[i] <= wallet->available() : committedBets() + handBets[i] <= money);
+}
+
+//moves the second card of hand i to a new hand with the same bet
+int Player::splitHand(int i) {
+    if (!reserveExtra(handBets[i])) return -1;   // another table took the money
+    const int n = hands++;
+    handRef(i).splitInto(handRef(n));
+    handBets[n] = handBets[i];
+    return n;
+}
+
+bool Player::doubleHand(int i) {
+    if (!reserveExtra(handBets[i])) return false;
+    handBets[i] *= 2;
+    lockHand(i);
+    return true;
+}
+
+//settles one hand without clearing anything (the Table clears once per round)
+void Player::settleHand(int i, int result) {
+    settleHandFor(i, result, result * handBets[i]);
+}
+
+//settles hand i with a given money delta; result only picks win/loss/push
+void Player::settleHandFor(int i, int result, int delta) {
+    if (wallet) {
+        wallet->settle(handBets[i], max(handBets[i] + delta, 0), walletTable);
+        reservedHere -= handBets[i];
+    }
+    money += delta;
+    if (result > 0) ++wins;
+    else if (result < 0) ++losses;
+    else ++pushes;
+    notePath();
+}
+
+void Player::showHand(int i) const {
+    cout << "[";
+    for (int c : handAt(i)) {
+        cout << c << ", ";
+    }
+    cout << "]";
+}
+
+void Player::clearHand() {
+    Person::clearHand();
+    for (int i = 1; i < hands; ++i) splits[i - 1].clear();
+    hands = 1;
+    lockedHands = 0;
+    handBets[0] = bet;
+    if (wallet) coverBet();
 }
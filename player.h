@@ -3,9 +3,13 @@
 #define PLAYER_H
 
 #include "person.h"
+#include <climits>
+#include <cstdint>
 #include <string>
 using namespace std;
 
+class Wallet;
+
 class Player : public Person
 {
 private:
@@ -19,14 +23,57 @@ private:
     int losses = 0;
     int pushes = 0;
 
+    // Bankroll path (updated on every settled hand)
+    int peakMoney;          // highest bankroll so far
+    int maxDrawdown = 0;    // largest fall from a peak
+    int handsSettled = 0;
+
+    // Split hands and per-hand bets, all inline (no heap in the round loop).
+    // Hand 0 is Person::hand; splits fill 1..kMaxHands-1.
+    Hand splits[3];
+    int handBets[4] = {};
+    uint8_t hands = 1;
+    uint8_t lockedHands = 0;  // bit i: hand i takes no more cards (doubled / split aces)
+
+    // Shared account (see attachWallet); null = the seat's own `money`.
+    Wallet* wallet = nullptr;
+    uint32_t walletTable = 0;
+    int reservedHere = 0;     // this seat's stakes currently reserved in the wallet
+
+    Hand& handRef(int i) { return i == 0 ? hand : splits[i - 1]; }
+    void notePath() {
+        ++handsSettled;
+        const int now = getMoney();
+        if (now > peakMoney) peakMoney = now;
+        else if (peakMoney - now > maxDrawdown) maxDrawdown = peakMoney - now;
+    }
+    bool reserveExtra(int amount);
+
 public:
+    static constexpr int kMaxHands = 4;  // original hand + three re-splits
+
     explicit Player(string inName, int inMoney);
 
     // Identity / money
     const string& getName() const;   // made const-safe
     int getMoney() const;
     int getStartingMoney() const { return startingMoney; }
-    int getNet() const { return money - startingMoney; }  // +gain / -loss
+    int getNet() const { return getMoney() - startingMoney; }  // +gain / -loss
+
+    // Shared wallet: the seat's bankroll becomes `w` (shared with seats at
+    // other tables). Bets are reserved in the wallet by setBet and again
+    // for every round (a bet set before attaching is kept and reserved at
+    // the first round), doubles and splits reserve their extra stake, and
+    // each hand settles its reservation; getMoney() is then the wallet's
+    // available money plus this seat's reservations. Attach a seat where
+    // it will stay (copies would share the reservation) and detach it
+    // before it goes away so its reservation is released.
+    void attachWallet(Wallet* w, uint32_t tableId);
+    void detachWallet();
+    Wallet* getWallet() const { return wallet; }
+    // Sets this round's stake to the bet, at most `cap` (the bet itself is
+    // kept), and reserves it with a wallet; false = sit the round out.
+    bool coverBet(int cap = INT_MAX);
 
     // Bets
     void setBet(int betAmount);
@@ -37,10 +84,31 @@ public:
     void handLost(int moneyLost);    // money -= moneyLost; ++losses
     void handPush();                 // no money change; ++pushes
 
+    // Multiple hands (split/double)
+    int handCount() const { return hands; }
+    const Hand& handAt(int i) const { return i == 0 ? hand : splits[i - 1]; }
+    int betOn(int i) const { return handBets[i]; }
+    int committedBets() const;                 // sum of every hand's bet
+    bool isHandLocked(int i) const { return (lockedHands >> i) & 1; }
+    bool canSplit(int i) const;                // pair, free hand slot, money for another bet
+    bool canDouble(int i) const;               // two cards, money to double the bet
+    void dealToHand(int i, int card) { handRef(i).add(card); }
+    int splitHand(int i);                      // returns the new hand's index, -1 if the wallet refused
+    bool doubleHand(int i);                    // doubles the bet and locks the hand; false if refused
+    void lockHand(int i) { lockedHands |= static_cast<uint8_t>(1u << i); }
+    void settleHand(int i, int result);        // +1 win / -1 loss / 0 push on hand i's bet
+    void settleHandFor(int i, int result, int delta);   // same, paying `delta` (a recorded payout)
+    void clearHand();                          // clears every hand (hides Person::clearHand)
+    using Person::showHand;
+    void showHand(int i) const;                // same format as Person::showHand
+
     // Stats accessors
     int getWins()   const { return wins; }
     int getLosses() const { return losses; }
     int getPushes() const { return pushes; }
+    int getPeakMoney() const { return peakMoney; }
+    int getMaxDrawdown() const { return maxDrawdown; }
+    int getHandsSettled() const { return handsSettled; }
 };
 
 #endif // PLAYER_H
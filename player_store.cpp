@@ -0,0 +1,65 @@
+/*
+ * PlayerStore Implementation
+ * --------------------------
+ * Seat creation and bulk hand clearing for the structure-of-arrays store.
+ */
+
+#include "player_store.h"
+#include <algorithm>
+
+/**
+ * intern(name)
+ * ------------
+ * Returns the existing id for a name, or assigns the next one.
+ */
+uint32_t NameTable::intern(const std::string& name) {
+    auto it = ids.find(name);
+    if (it != ids.end()) return it->second;
+    const uint32_t id = static_cast<uint32_t>(names.size());
+    names.push_back(name);
+    ids.emplace(name, id);
+    return id;
+}
+
+/**
+ * addSeat(name, bank)
+ * -------------------
+ * Appends one seat to every column; returns its index.
+ */
+size_t PlayerStore::addSeat(const std::string& name, int32_t bank) {
+    money.push_back(bank);
+    startingMoney.push_back(bank);
+    bet.push_back(0);
+    wins.push_back(0);
+    losses.push_back(0);
+    pushes.push_back(0);
+    nameId.push_back(names.intern(name));
+    handTotal.push_back(0);
+    softAces.push_back(0);
+    cardCount.push_back(0);
+    return money.size() - 1;
+}
+
+void PlayerStore::reserve(size_t n) {
+    money.reserve(n);
+    startingMoney.reserve(n);
+    bet.reserve(n);
+    wins.reserve(n);
+    losses.reserve(n);
+    pushes.reserve(n);
+    nameId.reserve(n);
+    handTotal.reserve(n);
+    softAces.reserve(n);
+    cardCount.reserve(n);
+}
+
+/**
+ * clearHands()
+ * ------------
+ * Three memsets; no per-seat work.
+ */
+void PlayerStore::clearHands() {
+    std::fill(handTotal.begin(), handTotal.end(), static_cast<uint8_t>(0));
+    std::fill(softAces.begin(), softAces.end(), static_cast<uint8_t>(0));
+    std::fill(cardCount.begin(), cardCount.end(), static_cast<uint8_t>(0));
+}
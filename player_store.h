@@ -0,0 +1,74 @@
+#ifndef PLAYER_STORE_H
+#define PLAYER_STORE_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * NameTable
+ * - Interns player names once; seats refer to them by a 32-bit id.
+ */
+class NameTable {
+public:
+    uint32_t intern(const std::string& name);
+    const std::string& name(uint32_t id) const { return names[id]; }
+    size_t size() const { return names.size(); }
+
+private:
+    std::vector<std::string> names;
+    std::unordered_map<std::string, uint32_t> ids;
+};
+
+/**
+ * PlayerStore
+ * - Structure-of-arrays seat storage for very large simulated populations:
+ *   one contiguous array per field instead of one Player object per seat.
+ * - A hand is kept as its running total plus the number of aces still
+ *   counted as 11 (no card vector), which is all settlement needs.
+ * - ~31 bytes per seat: money, starting money, bet, W/L/P, name id
+ *   (4 bytes each) and hand total, soft aces, card count (1 byte each).
+ *
+ * Table::startRound / playerHit / settleBets have PlayerStore overloads
+ * that walk these arrays front to back.
+ */
+class PlayerStore {
+public:
+    size_t addSeat(const std::string& name, int32_t bank);
+    size_t size() const { return money.size(); }
+    void reserve(size_t n);
+
+    // Hand helpers (every ace can drop from 11 to 1 as needed)
+    void dealTo(size_t seat, int card) {
+        int t = handTotal[seat] + card;
+        int a = softAces[seat] + (card == 11 ? 1 : 0);
+        while (t > 21 && a > 0) { t -= 10; --a; }
+        handTotal[seat] = static_cast<uint8_t>(t);
+        softAces[seat] = static_cast<uint8_t>(a);
+        ++cardCount[seat];
+    }
+    int handValue(size_t seat) const { return handTotal[seat]; }
+    bool isSoft(size_t seat) const { return softAces[seat] > 0; }
+    void clearHands();
+
+    const std::string& name(size_t seat) const { return names.name(nameId[seat]); }
+    int32_t net(size_t seat) const { return money[seat] - startingMoney[seat]; }
+
+    // Columns (public so round loops can stream through them directly)
+    std::vector<int32_t> money;
+    std::vector<int32_t> startingMoney;
+    std::vector<int32_t> bet;
+    std::vector<uint32_t> wins;
+    std::vector<uint32_t> losses;
+    std::vector<uint32_t> pushes;
+    std::vector<uint32_t> nameId;
+    std::vector<uint8_t> handTotal;
+    std::vector<uint8_t> softAces;
+    std::vector<uint8_t> cardCount;
+
+private:
+    NameTable names;
+};
+
+#endif // PLAYER_STORE_H
@@ -0,0 +1,176 @@
+/*
+ * Frame Renderer Implementation
+ * -----------------------------
+ * Console output is composed per frame and written once:
+ *  - FrameBuffer / FrameScope: cout goes into a string until the frame is
+ *    presented (end of the scope, or an input prompt via cin's tie).
+ *  - ScreenDiff: fixed-height regions on an ANSI terminal, redrawn row by
+ *    row only where the text changed.
+ */
+
+#include "render.h"
+#include "deck.h"
+#include "player.h"
+#include "strategy.h"
+#include "table.h"
+#include <iomanip>
+#include <memory>
+#include <sstream>
+
+using namespace std;
+
+FrameBuffer::int_type FrameBuffer::overflow(int_type c) {
+    if (!traits_type::eq_int_type(c, traits_type::eof())) frame.push_back(traits_type::to_char_type(c));
+    return traits_type::not_eof(c);
+}
+
+std::streamsize FrameBuffer::xsputn(const char* s, std::streamsize n) {
+    frame.append(s, static_cast<size_t>(n));
+    return n;
+}
+
+/**
+ * present()
+ * ---------
+ * One fwrite + fflush for the whole frame; empty frames write nothing
+ * and a buffer without a FILE drops its frames.
+ */
+void FrameBuffer::present() {
+    if (frame.empty()) return;
+    if (out) {
+        fwrite(frame.data(), 1, frame.size(), out);
+        fflush(out);
+    }
+    bytes += frame.size();
+    ++writes;
+    frame.clear();
+}
+
+FrameScope::FrameScope(FrameBuffer& frame)
+    : frame(frame), presenterStream(&presenter), savedCout(cout.rdbuf(&frame)), savedTie(cin.tie(&presenterStream)) {
+    presenter.frame = &frame;
+}
+
+FrameScope::~FrameScope() {
+    frame.present();
+    cin.tie(savedTie);
+    cout.rdbuf(savedCout);
+}
+
+/**
+ * setRegion(region, lines)
+ * ------------------------
+ * Stores the region's rows; the screen grows to fit new regions.
+ */
+void ScreenDiff::setRegion(size_t region, const vector<string>& lines) {
+    if (current.size() < (region + 1) * height) current.resize((region + 1) * height);
+    for (size_t i = 0; i < height; ++i)
+        current[region * height + i] = i < lines.size() ? lines[i] : string();
+}
+
+/**
+ * compose(out)
+ * ------------
+ * Rows are 1-based terminal rows: "\x1b[<row>;1H" moves there and
+ * "\x1b[K" clears what the old text left behind.
+ */
+void ScreenDiff::compose(string& out) {
+    const bool full = !diff || shown.size() != current.size();
+    if (full) out += "\x1b[H\x1b[2J";
+    for (size_t r = 0; r < current.size(); ++r) {
+        if (!full && current[r] == shown[r]) continue;
+        out += "\x1b[" + to_string(r + 1) + ";1H";
+        out += current[r];
+        out += "\x1b[K";
+        ++rows;
+    }
+    shown = current;
+    out += "\x1b[" + to_string(current.size() + 1) + ";1H";   // park the cursor below the screen
+}
+
+namespace {
+
+BotStrategy watchStrategy(int table) {
+    switch (table % 4) {
+    case 0: return BasicStrategy{};
+    case 1: return HiLoCounting{};
+    case 2: return HitBelow{ 17 };
+    default: return MimicDealer{};
+    }
+}
+
+struct WatchTable {
+    Deck deck;
+    Table table;
+    vector<unique_ptr<Player>> seats;
+    BotStrategy strategy;
+    int rounds = 0;
+    int dealerTotal = 0;
+
+    explicit WatchTable(int k) : deck(1000u + static_cast<unsigned int>(k), 6), table(deck), strategy(watchStrategy(k)) {
+        for (int s = 0; s < 3; ++s) {
+            seats.emplace_back(new Player("Seat" + to_string(s + 1), 1000));
+            seats.back()->setBet(10);
+            table.addPlayer(seats.back().get());
+        }
+    }
+
+    vector<string> lines(int k) const {
+        vector<string> out;
+        ostringstream head;
+        head << "Table " << (k + 1) << " (" << strategyName(strategy) << ")  round " << rounds
+             << "  dealer " << dealerTotal;
+        out.push_back(head.str());
+        for (const auto& p : seats) {
+            ostringstream row;
+            row << "  " << left << setw(6) << p->getName() << right << " $" << setw(6) << p->getMoney()
+                << "  W " << setw(4) << p->getWins() << " L " << setw(4) << p->getLosses()
+                << " P " << setw(4) << p->getPushes();
+            out.push_back(row.str());
+        }
+        return out;
+    }
+};
+
+} // namespace
+
+/**
+ * runTableWatch(tables, rounds, diff)
+ * -----------------------------------
+ * Bot tables (three seats each, strategy by table number) play one round
+ * per frame; each frame is one write of the composed screen.
+ */
+int runTableWatch(int tables, int rounds, bool diff) {
+    if (tables <= 0 || rounds <= 0) {
+        cout << "usage: watch [tables] [rounds] [full]\n";
+        return 1;
+    }
+    vector<unique_ptr<WatchTable>> all;
+    for (int k = 0; k < tables; ++k) all.emplace_back(new WatchTable(k));
+
+    const size_t regionHeight = 5;   // header + 3 seats + blank
+    ScreenDiff screen(regionHeight, diff);
+    FrameBuffer frame;
+    string out;
+    for (int r = 0; r < rounds; ++r) {
+        for (int k = 0; k < tables; ++k) {
+            WatchTable& w = *all[k];
+            RoundResult result;
+            if (w.table.playRounds(1, w.strategy, &result) == 1) {
+                ++w.rounds;
+                w.dealerTotal = result.dealerTotal;
+            }
+            screen.setRegion(static_cast<size_t>(k), w.lines(k));
+        }
+        out.clear();
+        screen.compose(out);
+        frame.sputn(out.data(), static_cast<streamsize>(out.size()));
+        frame.present();
+    }
+
+    const size_t totalRows = static_cast<size_t>(tables) * regionHeight * static_cast<size_t>(rounds);
+    cout << "frames: " << frame.presents() << "  bytes: " << frame.bytesWritten()
+         << "  rows redrawn: " << screen.rowsWritten() << " of " << totalRows
+         << (diff ? " (diff)" : " (full)") << "\n";
+    return 0;
+}
@@ -0,0 +1,100 @@
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <cstddef>
+#include <cstdio>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+/**
+ * FrameBuffer
+ * - std::streambuf that collects everything written to it into one string.
+ *   Flushes (endl, std::flush) are no-ops, so the per-line endl in Table,
+ *   Dealer and the driver costs nothing while a frame is open.
+ * - present() writes the whole frame with one fwrite + fflush (a single
+ *   write for frames that fit the stdio buffer) and starts a new frame.
+ *   With out == nullptr frames are composed and dropped (quiet runs).
+ */
+class FrameBuffer : public std::streambuf {
+public:
+    explicit FrameBuffer(FILE* out = stdout) : out(out) {}
+
+    void present();
+    const std::string& pending() const { return frame; }
+    size_t presents() const { return writes; }
+    size_t bytesWritten() const { return bytes; }
+
+protected:
+    int_type overflow(int_type c) override;
+    std::streamsize xsputn(const char* s, std::streamsize n) override;
+    int sync() override { return 0; }   // deferred to present()
+
+private:
+    FILE* out;
+    std::string frame;
+    size_t writes = 0;
+    size_t bytes = 0;
+};
+
+/**
+ * FrameScope
+ * - While alive, std::cout writes into a FrameBuffer; the destructor
+ *   presents the frame and puts cout back.
+ * - std::cin is tied to a stream that presents the frame, so an
+ *   interactive prompt is on screen before its input is read (the frame
+ *   then runs from one prompt to the next).
+ */
+class FrameScope {
+public:
+    explicit FrameScope(FrameBuffer& frame);
+    ~FrameScope();
+    FrameScope(const FrameScope&) = delete;
+    FrameScope& operator=(const FrameScope&) = delete;
+
+private:
+    // streambuf whose flush presents the frame (what cin's tie calls)
+    struct PresentOnFlush : std::streambuf {
+        FrameBuffer* frame = nullptr;
+        int sync() override { frame->present(); return 0; }
+    };
+
+    FrameBuffer& frame;
+    PresentOnFlush presenter;
+    std::ostream presenterStream;
+    std::streambuf* savedCout;
+    std::ostream* savedTie;
+};
+
+/**
+ * ScreenDiff
+ * - A multi-table screen: regions of `regionHeight` rows stacked top to
+ *   bottom, one per table, each set as a list of lines.
+ * - compose() appends the ANSI output for the next frame: the full screen
+ *   the first time (or with diff off), afterwards only the rows whose text
+ *   changed (cursor move + row + clear to end of line).
+ * - Lines past the region height are dropped; missing ones are blank.
+ */
+class ScreenDiff {
+public:
+    ScreenDiff(size_t regionHeight, bool diff = true) : height(regionHeight), diff(diff) {}
+
+    void setRegion(size_t region, const std::vector<std::string>& lines);
+    void compose(std::string& out);
+    void invalidate() { shown.clear(); }   // next compose redraws everything
+
+    size_t rowsWritten() const { return rows; }
+
+private:
+    size_t height;
+    bool diff;
+    std::vector<std::string> current;   // row-major: region * height + line
+    std::vector<std::string> shown;     // what the terminal holds
+    size_t rows = 0;
+};
+
+// Driver mode "watch [tables] [rounds] [full]".
+int runTableWatch(int tables, int rounds, bool diff);
+
+#endif // RENDER_H
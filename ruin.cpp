@@ -0,0 +1,222 @@
+/*
+ * Risk of Ruin Implementation
+ * ---------------------------
+ * estimateRuin splits the paths across threads; each thread has its own
+ * seeded generator and RunningStat of per-path weights (0 for survivors),
+ * merged at the end. The tilt is found once up front by bisection.
+ */
+
+#include "ruin.h"
+#include "betramp.h"
+#include "deck.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+// Step distribution used for sampling: values with cumulative sampling
+// probabilities, plus log M(theta) for the likelihood ratio.
+struct StepTable {
+    vector<int> values;
+    vector<double> cumulative;
+    double theta = 0.0;
+    double logM = 0.0;
+
+    int draw(mt19937_64& rng) const {
+        const double u = generate_canonical<double, 53>(rng);
+        size_t i = 0;
+        while (i + 1 < cumulative.size() && u >= cumulative[i]) ++i;
+        return values[i];
+    }
+};
+
+// mean of the distribution tilted by theta
+double tiltedMean(const OutcomeDistribution& d, double theta) {
+    double m = 0.0, s = 0.0;
+    for (size_t i = 0; i < d.values.size(); ++i) {
+        const double w = d.probability(i) * exp(theta * d.values[i]);
+        m += w * d.values[i];
+        s += w;
+    }
+    return s > 0 ? m / s : 0.0;
+}
+
+// theta <= 0 whose tilted drift is `target` (0 if the walk already gets there)
+double solveTilt(const OutcomeDistribution& d, double target) {
+    if (d.mean() <= target) return 0.0;
+    double lo = -1.0, hi = 0.0;
+    while (tiltedMean(d, lo) > target && lo > -64.0) lo *= 2;
+    for (int it = 0; it < 100; ++it) {
+        const double mid = 0.5 * (lo + hi);
+        if (tiltedMean(d, mid) > target) hi = mid;
+        else lo = mid;
+    }
+    return 0.5 * (lo + hi);
+}
+
+StepTable makeSteps(const OutcomeDistribution& d, double theta) {
+    StepTable t;
+    t.theta = theta;
+    double m = 0.0;
+    for (size_t i = 0; i < d.values.size(); ++i) m += d.probability(i) * exp(theta * d.values[i]);
+    t.logM = log(m);
+    double acc = 0.0;
+    for (size_t i = 0; i < d.values.size(); ++i) {
+        acc += d.probability(i) * exp(theta * d.values[i]) / m;
+        t.values.push_back(d.values[i]);
+        t.cumulative.push_back(acc);
+    }
+    return t;
+}
+
+// "1,2,4,8" -> bets at true counts 1, 2, 3, 4+ (one unit at 0 and below)
+bool parseRamp(const string& text, vector<int>& bets) {
+    bets.assign(static_cast<size_t>(1 - CountOutcomes::kMinCount), 1);
+    istringstream in(text);
+    string item;
+    while (getline(in, item, ',')) {
+        size_t used = 0;
+        int bet = 0;
+        try {
+            bet = stoi(item, &used);
+        }
+        catch (...) {
+            return false;
+        }
+        if (used != item.size() || bet < 1) return false;
+        bets.push_back(bet);
+    }
+    return bets.size() > static_cast<size_t>(1 - CountOutcomes::kMinCount);
+}
+
+BetRamp rampOf(const RuinConfig& cfg) {
+    BetRamp ramp;
+    for (size_t i = 0; i < ramp.bets.size() && !cfg.rampBets.empty(); ++i)
+        ramp.bets[i] = cfg.rampBets[min(i, cfg.rampBets.size() - 1)];
+    return ramp;
+}
+
+} // namespace
+
+/**
+ * sampleRuinOutcomes(cfg)
+ * -----------------------
+ * Flat: the basic-strategy outcome distribution. Ramp: the Hi-Lo counting
+ * seat's per-count distributions, each scaled by the ramp's bet there.
+ */
+OutcomeDistribution sampleRuinOutcomes(const RuinConfig& cfg) {
+    if (cfg.rampBets.empty()) return sampleOutcomes(cfg.rules, cfg.seed, cfg.decks, cfg.sampleShoes, cfg.threads);
+    return rampOutcomes(sampleCountOutcomes(cfg.rules, cfg.seed, cfg.decks, cfg.sampleShoes, cfg.threads), rampOf(cfg));
+}
+
+/**
+ * estimateRuin(outcomes, cfg)
+ * ---------------------------
+ * Ruin means the bankroll drops below one bet (< 1 unit) within the
+ * horizon. Returns the estimate and its standard error.
+ */
+RuinResult estimateRuin(const OutcomeDistribution& outcomes, const RuinConfig& cfg) {
+    RuinResult result;
+    if (outcomes.total == 0 || cfg.paths <= 0 || cfg.bankroll < 1) {
+        result.probability = cfg.bankroll < 1 ? 1.0 : 0.0;
+        return result;
+    }
+    // Can't lose bankroll units in horizon rounds even losing every one
+    const double worstStep = min(outcomes.values.front(), 0);
+    if (-worstStep * static_cast<double>(cfg.horizon) < cfg.bankroll) return result;
+
+    const double theta = cfg.importance
+        ? solveTilt(outcomes, -static_cast<double>(cfg.bankroll) / static_cast<double>(cfg.horizon))
+        : 0.0;
+    const StepTable steps = makeSteps(outcomes, theta);
+
+    size_t n = cfg.threads > 0 ? static_cast<size_t>(cfg.threads) : thread::hardware_concurrency();
+    if (n == 0) n = 1;
+    if (cfg.paths < static_cast<long long>(n)) n = static_cast<size_t>(cfg.paths);
+
+    vector<RunningStat> weights(n);
+    vector<long long> ruined(n, 0);
+    vector<thread> workers;
+    for (size_t t = 0; t < n; ++t) {
+        const long long share = cfg.paths / static_cast<long long>(n)
+            + (static_cast<long long>(t) < cfg.paths % static_cast<long long>(n) ? 1 : 0);
+        workers.emplace_back([&, t, share]() {
+            mt19937_64 rng(Deck::shoeSeed(cfg.seed, static_cast<int>(t)));
+            RunningStat& w = weights[t];
+            for (long long p = 0; p < share; ++p) {
+                long long bank = cfg.bankroll;
+                long long sum = 0, r = 0;
+                while (r < cfg.horizon && bank >= 1 && (cfg.winGoal <= 0 || bank < cfg.winGoal)) {
+                    const int x = steps.draw(rng);
+                    sum += x;
+                    bank += x;
+                    ++r;
+                }
+                if (bank < 1) {
+                    ++ruined[t];
+                    w.add(exp(-steps.theta * sum + r * steps.logM));
+                }
+                else {
+                    w.add(0.0);
+                }
+            }
+        });
+    }
+    for (thread& w : workers) w.join();
+
+    RunningStat total;
+    for (size_t t = 0; t < n; ++t) {
+        total.merge(weights[t]);
+        result.ruinedPaths += ruined[t];
+    }
+    result.paths = total.n;
+    result.probability = total.mean();
+    result.stdError = total.n ? sqrt(total.variance() / total.n) : 0.0;
+    result.tilt = theta;
+    return result;
+}
+
+/**
+ * runRuinTool(bankroll, horizon, paths, importance, threads, hitSoft17, ramp)
+ * ---------------------------------------------------------------------------
+ * Builds the outcome distribution from 20,000 simulated 6-deck shoes under
+ * the given rules and bet policy, then prints the ruin estimate.
+ */
+int runRuinTool(int bankroll, long long horizon, long long paths, bool importance, int threads,
+    bool hitSoft17, const string& ramp) {
+    RuinConfig cfg;
+    if (bankroll < 1 || horizon < 1 || paths < 1 || (!ramp.empty() && !parseRamp(ramp, cfg.rampBets))) {
+        cout << "usage: sim-ruin [bankroll units] [horizon rounds] [paths] [is|mc] [threads] [s17|h17] [ramp]\n"
+             << "  ramp: bets in units at true counts 1, 2, ... (last one for every count above), e.g. 1,2,4,8\n";
+        return 1;
+    }
+    cfg.bankroll = bankroll;
+    cfg.horizon = horizon;
+    cfg.paths = paths;
+    cfg.importance = importance;
+    cfg.seed = 20250101u;
+    cfg.threads = threads;
+    cfg.rules.hitSoft17 = hitSoft17;
+    const OutcomeDistribution d = sampleRuinOutcomes(cfg);
+    const RuinResult r = estimateRuin(d, cfg);
+
+    cout << "=== Risk of ruin: " << bankroll << " units, " << horizon << " rounds, "
+         << r.paths << (importance ? " importance-sampled" : " plain") << " paths ===\n";
+    cout << (hitSoft17 ? "H17" : "S17") << ", " << (cfg.rampBets.empty() ? "flat betting" : "Hi-Lo ramp " + rampOf(cfg).describe()) << "\n";
+    cout << fixed << setprecision(4);
+    cout << "per-round EV " << d.mean() << " units, SD " << sqrt(d.variance())
+         << " (" << d.total << " simulated rounds)\n";
+    cout << scientific << setprecision(3);
+    cout << "P(ruin) = " << r.probability << " +/- " << 1.96 * r.stdError << " (95%)\n";
+    cout << "ruined paths: " << r.ruinedPaths << ", tilt theta = " << fixed << setprecision(4) << r.tilt << "\n";
+    cout << scientific << setprecision(2) << "plain Monte Carlo would need ~" << r.equivalentPlainPaths()
+         << " paths for this precision\n";
+    return 0;
+}
@@ -0,0 +1,71 @@
+#ifndef RUIN_H
+#define RUIN_H
+
+#include "simulation.h"
+#include <string>
+#include <vector>
+
+/**
+ * Risk of ruin
+ * - Bankroll paths are random walks whose steps are drawn from a simulated
+ *   per-round OutcomeDistribution (see sampleOutcomes), times the bet.
+ * - A path is ruined once the bankroll can no longer cover one bet, and
+ *   stops there, at the win goal (if any) or after `horizon` rounds.
+ * - What is played comes from RuinConfig: the table rules, the decks and
+ *   the bet policy. Flat betting samples sampleOutcomes; a count-based
+ *   ramp samples sampleCountOutcomes once and mixes the per-count
+ *   distributions with the ramp's bets (rampOutcomes, betramp.h), so the
+ *   steps are in table-minimum units either way.
+ *
+ * Modes:
+ *  - plain Monte Carlo: draw steps from the distribution as-is; simple and
+ *    unbiased, but needs ~100/p paths to see a probability p at all.
+ *  - importance sampling: draw steps from the exponentially tilted
+ *    distribution q(x) ~ p(x) e^(theta x), with theta chosen so the tilted
+ *    drift just reaches ruin by the horizon, and weight every ruined path
+ *    by its likelihood ratio e^(-theta S) M(theta)^n. Rare ruins become
+ *    common and the weights keep the estimate unbiased.
+ */
+struct RuinConfig {
+    int bankroll = 100;         // in units of the (minimum) bet
+    int winGoal = 0;            // stop once the bankroll reaches this (0 = never)
+    long long horizon = 10000;  // rounds per path
+    long long paths = 100000;
+    bool importance = true;
+    unsigned int seed = 1;
+    int threads = 0;            // 0 = all cores
+
+    // Game the steps are sampled from (sampleRuinOutcomes)
+    RuleSet rules;
+    int decks = 6;
+    long long sampleShoes = 20000;
+    // Hi-Lo bet ramp: rampBets[i] units at true count CountOutcomes::kMinCount + i,
+    // the last entry for every count above; empty = flat one unit
+    std::vector<int> rampBets;
+};
+
+struct RuinResult {
+    long long paths = 0;
+    long long ruinedPaths = 0;  // under the sampling distribution
+    double probability = 0.0;
+    double stdError = 0.0;
+    double tilt = 0.0;          // theta (0 = plain Monte Carlo)
+
+    // Paths plain Monte Carlo would need for the same standard error.
+    double equivalentPlainPaths() const {
+        return stdError > 0 ? probability * (1 - probability) / (stdError * stdError) : 0.0;
+    }
+};
+
+RuinResult estimateRuin(const OutcomeDistribution& outcomes, const RuinConfig& cfg);
+
+// Per-round outcomes of cfg's rules, decks and bet policy, in units.
+OutcomeDistribution sampleRuinOutcomes(const RuinConfig& cfg);
+
+// Driver mode "sim-ruin [bankroll] [horizon] [paths] [is|mc] [threads] [s17|h17] [ramp]":
+// basic strategy, flat or with a ramp such as "1,2,4,8" (bets at true
+// counts 1, 2, 3 and 4+; one unit at 0 and below).
+int runRuinTool(int bankroll, long long horizon, long long paths, bool importance, int threads,
+    bool hitSoft17 = false, const std::string& ramp = "");
+
+#endif // RUIN_H
@@ -0,0 +1,318 @@
+/*
+ * House Rules Configuration Implementation
+ * ----------------------------------------
+ * Publishing: the new version is swapped into `live`, then the epoch is
+ * bumped and the old version is retired with that epoch. A Reader stores
+ * the current epoch in its slot before it loads `live`, so a Reader that
+ * has announced epoch e can only hold versions published at or after e's
+ * swap; every version retired at an epoch <= the smallest announcement is
+ * unreachable and is freed. All of these are sequentially consistent
+ * operations, which is what makes "announce, then load" safe.
+ */
+
+#include "rules.h"
+#include "deck.h"
+#include "numa.h"
+#include "player.h"
+#include "strategy.h"
+#include "table.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+using namespace std;
+
+namespace {
+
+string trim(const string& s) {
+    const size_t first = s.find_first_not_of(" \t\r");
+    if (first == string::npos) return "";
+    return s.substr(first, s.find_last_not_of(" \t\r") - first + 1);
+}
+
+bool readFile(const string& path, string& text) {
+    ifstream in(path, ios::binary);
+    if (!in) return false;
+    ostringstream all;
+    all << in.rdbuf();
+    text = all.str();
+    return true;
+}
+
+} // namespace
+
+/**
+ * parseRules(text, out, error)
+ * ----------------------------
+ * Starts from the defaults, applies every "key = value" line, then checks
+ * the ranges (min <= max, seats within a table). `out` is only written
+ * when the whole file is good.
+ */
+bool parseRules(const string& text, TableRules& out, string* error) {
+    TableRules r;
+    istringstream in(text);
+    string line;
+    int lineNo = 0;
+    auto fail = [&](const string& why) {
+        if (error) *error = (lineNo > 0 ? "line " + to_string(lineNo) + ": " : string()) + why;
+        return false;
+    };
+    while (getline(in, line)) {
+        ++lineNo;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+        const size_t eq = line.find('=');
+        if (eq == string::npos) return fail("expected key = value");
+        const string key = trim(line.substr(0, eq));
+        const string value = trim(line.substr(eq + 1));
+
+        if (key == "hit_soft_17") {
+            if (value == "true" || value == "1") r.hitSoft17 = true;
+            else if (value == "false" || value == "0") r.hitSoft17 = false;
+            else return fail("hit_soft_17 must be true or false");
+            continue;
+        }
+        int* field = key == "min_players" ? &r.minPlayers : key == "max_players" ? &r.maxPlayers
+            : key == "min_bank" ? &r.minBank : key == "max_bank" ? &r.maxBank
+            : key == "min_bet" ? &r.minBet : key == "max_bet" ? &r.maxBet : nullptr;
+        if (!field) return fail("unknown key '" + key + "'");
+        size_t used = 0;
+        try {
+            *field = stoi(value, &used);
+        }
+        catch (...) {
+            used = 0;
+        }
+        if (used == 0 || used != value.size()) return fail(key + " must be a whole number");
+    }
+
+    lineNo = 0;
+    if (r.minPlayers < 1 || r.maxPlayers > TableRules::kMaxSeats || r.minPlayers > r.maxPlayers)
+        return fail("players must satisfy 1 <= min_players <= max_players <= 7");
+    if (r.minBank < 1 || r.minBank > r.maxBank) return fail("bank must satisfy 1 <= min_bank <= max_bank");
+    if (r.minBet < 1 || r.minBet > r.maxBet) return fail("bets must satisfy 1 <= min_bet <= max_bet");
+    out = r;
+    return true;
+}
+
+RuleConfig::RuleConfig(const TableRules& initial) : slots(new Slot[kMaxReaders]) {
+    TableRules first = initial;
+    first.version = lastVersion = 1;
+    live.store(new TableRules(first));
+}
+
+RuleConfig::~RuleConfig() {
+    delete live.load();
+    for (const auto& r : retired) delete r.second;
+}
+
+/**
+ * publish(next)
+ * -------------
+ * Makes `next` the live rules. Readers pick it up at their next refresh;
+ * until then they keep the version they have, which stays allocated.
+ */
+uint64_t RuleConfig::publish(TableRules next) {
+    lock_guard<mutex> g(writer);
+    next.version = ++lastVersion;
+    const TableRules* old = live.exchange(new TableRules(next));
+    const uint64_t retiredAt = epoch.fetch_add(1) + 1;
+    retired.emplace_back(retiredAt, old);
+    collect();
+    return next.version;
+}
+
+void RuleConfig::collect() {
+    if (unslotted.load() > 0) return;
+    uint64_t oldest = numeric_limits<uint64_t>::max();
+    for (int i = 0; i < kMaxReaders; ++i) {
+        const uint64_t seen = slots[i].seen.load();
+        if (seen != 0) oldest = min(oldest, seen);
+    }
+    auto done = [oldest](const pair<uint64_t, const TableRules*>& r) {
+        if (r.first > oldest) return false;
+        delete r.second;
+        return true;
+    };
+    retired.erase(remove_if(retired.begin(), retired.end(), done), retired.end());
+}
+
+bool RuleConfig::reload(const string& path, string* error) { return load(path, false, error); }
+bool RuleConfig::reloadIfChanged(const string& path, string* error) { return load(path, true, error); }
+
+// Reads and parses outside the writer lock; a bad file leaves the live
+// rules alone.
+bool RuleConfig::load(const string& path, bool onlyIfChanged, string* error) {
+    string text;
+    if (!readFile(path, text)) {
+        if (error) *error = "cannot open " + path;
+        return false;
+    }
+    {
+        lock_guard<mutex> g(writer);
+        collect();                      // readers that refreshed since the last swap
+        if (onlyIfChanged && text == watchedText) return false;
+        watchedText = text;
+    }
+    TableRules next;
+    if (!parseRules(text, next, error)) return false;
+    publish(next);
+    return true;
+}
+
+TableRules RuleConfig::snapshot() const {
+    lock_guard<mutex> g(writer);        // versions are only freed under this lock
+    return *live.load();
+}
+
+uint64_t RuleConfig::version() const {
+    lock_guard<mutex> g(writer);
+    return lastVersion;
+}
+
+size_t RuleConfig::pendingVersions() const {
+    lock_guard<mutex> g(writer);
+    return retired.size();
+}
+
+/**
+ * Reader(config)
+ * --------------
+ * Claims a free announcement slot (announcing the current epoch in the
+ * same CAS), then loads the live version.
+ */
+RuleConfig::Reader::Reader(RuleConfig& inConfig) : config(inConfig), slot(-1), current(nullptr) {
+    for (int i = 0; i < kMaxReaders && slot < 0; ++i) {
+        uint64_t expected = 0;
+        if (config.slots[i].seen.compare_exchange_strong(expected, config.epoch.load())) slot = i;
+    }
+    if (slot < 0) config.unslotted.fetch_add(1);
+    current = config.live.load();
+}
+
+RuleConfig::Reader::~Reader() {
+    if (slot >= 0) config.slots[slot].seen.store(0);
+    else config.unslotted.fetch_sub(1);
+}
+
+bool RuleConfig::Reader::refresh() {
+    if (slot >= 0) config.slots[slot].seen.store(config.epoch.load());
+    const TableRules* newest = config.live.load();
+    if (newest == current) return false;
+    current = newest;
+    return true;
+}
+
+RuleWatcher::RuleWatcher(RuleConfig& inConfig, string inPath, double intervalSeconds)
+    : config(inConfig), path(move(inPath)), interval(intervalSeconds) {
+    worker = thread([this]() {
+        unique_lock<mutex> lock(m);
+        while (!stopping) {
+            lock.unlock();
+            string why;
+            const bool reloaded = config.reloadIfChanged(path, &why);
+            lock.lock();
+            if (reloaded) {
+                reloadCount.fetch_add(1, memory_order_relaxed);
+                error.clear();
+            }
+            else if (!why.empty() && why != error) {
+                rejectCount.fetch_add(1, memory_order_relaxed);   // reported once per distinct problem
+                error = why;
+            }
+            cv.wait_for(lock, chrono::duration<double>(interval), [this]() { return stopping; });
+        }
+    });
+}
+
+RuleWatcher::~RuleWatcher() {
+    {
+        lock_guard<mutex> g(m);
+        stopping = true;
+    }
+    cv.notify_all();
+    worker.join();
+}
+
+string RuleWatcher::lastError() const {
+    lock_guard<mutex> g(m);
+    return error;
+}
+
+/**
+ * runReloadTool(path, tables, seconds)
+ * ------------------------------------
+ * Every table plays batches of rounds with basic strategy, refreshing its
+ * rules between rounds; the main thread reports each version that goes
+ * live. At the end each table shows the last version it played under.
+ */
+int runReloadTool(const string& path, int tables, double seconds) {
+    if (path.empty() || tables < 1 || seconds <= 0.0) {
+        cout << "usage: sim-reload [rules file] [tables] [seconds]\n";
+        return 1;
+    }
+    RuleConfig config;
+    string why;
+    if (!config.reload(path, &why)) cout << "(" << why << "; house defaults until that changes)\n";
+
+    atomic<bool> stop{ false };
+    vector<long long> rounds(static_cast<size_t>(tables), 0);
+    vector<uint64_t> lastSeen(static_cast<size_t>(tables), 0);
+    thread play([&]() {
+        numa::runPinned(static_cast<size_t>(tables), [&](size_t t) {
+            Deck deck(Deck::shoeSeed(11u, static_cast<int>(t)), 6);
+            Table table(deck);
+            vector<unique_ptr<Player>> seats;
+            for (int s = 0; s < 3; ++s) {
+                seats.push_back(make_unique<Player>("seat", 1 << 30));
+                seats.back()->setBet(25);
+                table.addPlayer(seats.back().get());
+            }
+            RuleConfig::Reader reader(config);
+            table.setRules(&reader);
+            BasicStrategy policy;
+            RoundResult results[16];
+            long long played = 0;
+            while (!stop.load(memory_order_relaxed)) played += static_cast<long long>(table.playRounds(16, policy, results));
+            rounds[t] = played;
+            lastSeen[t] = reader.get().version;
+            table.setRules(nullptr);
+        });
+    });
+
+    cout << "watching " << path << " (" << tables << " tables, " << seconds << " s); edit it to change the rules\n";
+    {
+        RuleWatcher watcher(config, path, 0.2);
+        uint64_t shown = 0, rejected = 0;
+        const auto end = chrono::steady_clock::now() + chrono::duration<double>(seconds);
+        while (chrono::steady_clock::now() < end) {
+            const TableRules r = config.snapshot();
+            if (r.version != shown) {
+                shown = r.version;
+                cout << "v" << r.version << " live: " << (r.hitSoft17 ? "H17" : "S17") << ", bets $" << r.minBet
+                    << "-$" << r.maxBet << ", " << r.minPlayers << "-" << r.maxPlayers << " players, bank $"
+                    << r.minBank << "-$" << r.maxBank << "\n";
+            }
+            if (watcher.rejects() != rejected) {
+                rejected = watcher.rejects();
+                cout << "rejected: " << watcher.lastError() << " (still on v" << shown << ")\n";
+            }
+            this_thread::sleep_for(chrono::milliseconds(50));
+        }
+    }
+    stop.store(true);
+    play.join();
+
+    cout << left << setw(8) << "Table" << right << setw(14) << "Rounds" << setw(14) << "Last rules" << "\n";
+    cout << string(36, '-') << "\n";
+    for (int t = 0; t < tables; ++t)
+        cout << left << setw(8) << t << right << setw(14) << rounds[static_cast<size_t>(t)]
+            << setw(13) << "v" << lastSeen[static_cast<size_t>(t)] << "\n";
+    cout << string(36, '-') << "\n";
+    cout << config.version() << " version(s) published, " << config.pendingVersions() << " awaiting reclamation\n";
+    return 0;
+}
@@ -0,0 +1,147 @@
+#ifndef RULES_H
+#define RULES_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * TableRules
+ * - House rules and limits that used to be compiled in: dealer soft 17,
+ *   seats per game, starting bank range and bet range. Wins pay even
+ *   money; that is not configurable.
+ * - Config file: one "key = value" per line, '#' starts a comment:
+ *     # Saturday night
+ *     hit_soft_17 = true
+ *     min_bet = 25
+ *     max_bet = 5000
+ *   Keys: hit_soft_17, min_players / max_players (1-7), min_bank /
+ *   max_bank, min_bet / max_bet. Keys left out keep the defaults below;
+ *   an unknown key or a bad value rejects the whole file.
+ */
+struct TableRules {
+    static constexpr int kMaxSeats = 7;
+
+    bool hitSoft17 = false;
+    int minPlayers = 1;
+    int maxPlayers = 4;
+    int minBank = 100;
+    int maxBank = 10000;
+    int minBet = 1;
+    int maxBet = 10000;
+    uint64_t version = 0;       // set by RuleConfig::publish
+
+    int clampBet(int bet) const { return bet < minBet ? minBet : (bet > maxBet ? maxBet : bet); }
+};
+
+// Parses a rules file's text; false (with a line-numbered message) if bad.
+bool parseRules(const std::string& text, TableRules& out, std::string* error = nullptr);
+
+/**
+ * RuleConfig
+ * - The live rules of a multi-table process, swapped RCU-style: publish()
+ *   builds a new immutable TableRules and swaps the pointer in one atomic
+ *   exchange. Tables never lock and never wait for a writer.
+ * - Each table thread reads through its own Reader, which keeps one
+ *   version for as long as it likes and only moves to the newest at
+ *   refresh() - the table calls that between rounds, so a round is always
+ *   played under one set of rules.
+ * - Reclamation is quiescent-state based: a Reader announces the epoch it
+ *   saw on every refresh(), and a replaced version is freed once every
+ *   Reader has announced a later epoch (or gone away). Writers serialize
+ *   on a mutex; readers only touch atomics.
+ * - Up to kMaxReaders Readers get an announcement slot; past that a
+ *   Reader still works, but nothing is freed while it exists.
+ */
+class RuleConfig {
+public:
+    static constexpr int kMaxReaders = 256;
+
+    class Reader {
+    public:
+        explicit Reader(RuleConfig& config);
+        ~Reader();
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+
+        const TableRules& get() const { return *current; }
+        bool refresh();                 // quiescent point; true if the rules changed
+
+    private:
+        RuleConfig& config;
+        int slot;                       // -1 = no announcement slot
+        const TableRules* current;
+    };
+
+    explicit RuleConfig(const TableRules& initial = TableRules());
+    ~RuleConfig();                      // every Reader must be gone
+    RuleConfig(const RuleConfig&) = delete;
+    RuleConfig& operator=(const RuleConfig&) = delete;
+
+    uint64_t publish(TableRules next);  // returns the new version
+    bool reload(const std::string& path, std::string* error = nullptr);
+    // Reloads when the file's text changed since the last call; true if a
+    // new version went live.
+    bool reloadIfChanged(const std::string& path, std::string* error = nullptr);
+
+    TableRules snapshot() const;        // a copy of the live rules (writer side)
+    uint64_t version() const;
+    size_t pendingVersions() const;     // replaced but not yet freed
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> seen{ 0 };  // 0 = free, else the last epoch announced
+    };
+
+    std::atomic<const TableRules*> live;
+    std::atomic<uint64_t> epoch{ 1 };
+    std::atomic<int> unslotted{ 0 };
+    std::unique_ptr<Slot[]> slots;
+
+    mutable std::mutex writer;
+    std::vector<std::pair<uint64_t, const TableRules*>> retired;   // (epoch, version)
+    uint64_t lastVersion = 0;
+    std::string watchedText;            // file text seen by reloadIfChanged
+
+    bool load(const std::string& path, bool onlyIfChanged, std::string* error);
+    void collect();                     // writer lock held
+};
+
+/**
+ * RuleWatcher
+ * - Background thread that calls reloadIfChanged(path) every `interval`
+ *   seconds until destroyed, so editing the file is all an operator does.
+ */
+class RuleWatcher {
+public:
+    RuleWatcher(RuleConfig& config, std::string path, double intervalSeconds = 1.0);
+    ~RuleWatcher();
+
+    uint64_t reloads() const { return reloadCount.load(std::memory_order_relaxed); }
+    uint64_t rejects() const { return rejectCount.load(std::memory_order_relaxed); }
+    std::string lastError() const;
+
+private:
+    RuleConfig& config;
+    std::string path;
+    double interval;
+    std::atomic<uint64_t> reloadCount{ 0 };
+    std::atomic<uint64_t> rejectCount{ 0 };
+    mutable std::mutex m;
+    std::condition_variable cv;
+    bool stopping = false;
+    std::string error;
+    std::thread worker;
+};
+
+// Driver mode "sim-reload [rules file] [tables] [seconds]": bot tables on
+// their own threads while the file is watched; edit it to see the swap.
+int runReloadTool(const std::string& path, int tables, double seconds);
+
+#endif // RULES_H
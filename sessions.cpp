@@ -0,0 +1,151 @@
+/*
+ * Session Population Simulation Implementation
+ * --------------------------------------------
+ * A shard plays its sessions a table at a time: seatsPerTable fresh
+ * players, rounds through Table::playRounds until every seat is broke or
+ * the round cap is hit, then each seat is recorded with the rounds it
+ * actually played (a round counts if it settled a hand for the seat).
+ * The table's shoe runs on from one table to the next.
+ */
+
+#include "sessions.h"
+#include "deck.h"
+#include "strategy.h"
+#include "table.h"
+#include "numa.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+void SessionSketches::record(const Player& p, int roundsPlayed) {
+    endingBankroll.add(p.getMoney());
+    handsPlayed.add(p.getHandsSettled());
+    maxDrawdown.add(p.getMaxDrawdown());
+    ++sessions;
+    if (p.getMoney() <= 0) {
+        ++ruined;
+        roundsToRuin.add(roundsPlayed);
+    }
+}
+
+void SessionSketches::merge(const SessionSketches& other) {
+    endingBankroll.merge(other.endingBankroll);
+    handsPlayed.merge(other.handsPlayed);
+    maxDrawdown.merge(other.maxDrawdown);
+    roundsToRuin.merge(other.roundsToRuin);
+    sessions += other.sessions;
+    ruined += other.ruined;
+}
+
+size_t SessionSketches::memoryBytes() const {
+    return endingBankroll.memoryBytes() + handsPlayed.memoryBytes() + maxDrawdown.memoryBytes()
+        + roundsToRuin.memoryBytes();
+}
+
+namespace {
+
+// Plays sessions [first, last) of the population into `out`.
+void playShard(const SessionSimConfig& cfg, int shard, long long first, long long last, SessionSketches& out) {
+    Deck deck(Deck::shoeSeed(cfg.seed, shard), cfg.decks);
+    BasicStrategy policy;
+    RoundResult result;
+    const int seats = max(cfg.seatsPerTable, 1);
+    for (long long s = first; s < last; s += seats) {
+        const int here = static_cast<int>(min<long long>(seats, last - s));
+        vector<unique_ptr<Player>> players;
+        vector<int> rounds(static_cast<size_t>(here), 0);
+        Table table(deck);
+        for (int i = 0; i < here; ++i) {
+            players.push_back(make_unique<Player>("sim", cfg.bankroll));
+            players.back()->setBet(cfg.bet);
+            table.addPlayer(players.back().get());
+        }
+        for (int round = 0; round < cfg.maxRounds; ++round) {
+            if (none_of(players.begin(), players.end(), [](const unique_ptr<Player>& p) { return p->getMoney() > 0; }))
+                break;
+            vector<int> before(static_cast<size_t>(here));
+            for (int i = 0; i < here; ++i) before[i] = players[i]->getHandsSettled();
+            table.playRounds(1, policy, &result);
+            for (int i = 0; i < here; ++i) rounds[i] += players[i]->getHandsSettled() != before[i];
+        }
+        for (int i = 0; i < here; ++i) out.record(*players[i], rounds[i]);
+    }
+}
+
+} // namespace
+
+/**
+ * simulateSessions(cfg)
+ * ---------------------
+ * Shard s plays sessions [s * n / shards, (s + 1) * n / shards); pinned
+ * worker t takes shards t, t + threads, ... and builds each shard's
+ * sketches itself (node-local), moving them into place when done.
+ */
+SessionSketches simulateSessions(const SessionSimConfig& cfg) {
+    const int shards = static_cast<int>(max(1LL, min<long long>(cfg.shards, cfg.sessions)));
+    size_t n = cfg.threads > 0 ? static_cast<size_t>(cfg.threads) : thread::hardware_concurrency();
+    n = max<size_t>(1, min(n, static_cast<size_t>(shards)));
+
+    vector<SessionSketches> partial(static_cast<size_t>(shards));
+    numa::runPinned(n, [&](size_t t) {
+        for (int s = static_cast<int>(t); s < shards; s += static_cast<int>(n)) {
+            const long long first = cfg.sessions * s / shards;
+            const long long last = cfg.sessions * (s + 1) / shards;
+            SessionSketches local(Deck::shoeSeed(cfg.seed, s));
+            playShard(cfg, s, first, last, local);
+            partial[static_cast<size_t>(s)] = move(local);
+        }
+    });
+
+    SessionSketches total(cfg.seed);
+    for (const SessionSketches& p : partial) total.merge(p);
+    return total;
+}
+
+/**
+ * runSessionTool(sessions, bankroll, bet, maxRounds, threads)
+ * -----------------------------------------------------------
+ * Prints percentiles of the ending bankroll, hands played and largest
+ * drawdown over the simulated population, and of the rounds it took the
+ * broke sessions to go broke.
+ */
+int runSessionTool(long long sessions, int bankroll, int bet, int maxRounds, int threads) {
+    if (sessions <= 0 || bet <= 0 || bankroll < bet || maxRounds <= 0) {
+        cout << "usage: sim-sessions [sessions] [bankroll] [bet <= bankroll] [max rounds] [threads]\n";
+        return 1;
+    }
+    SessionSimConfig cfg;
+    cfg.sessions = sessions;
+    cfg.bankroll = bankroll;
+    cfg.bet = bet;
+    cfg.maxRounds = maxRounds;
+    cfg.threads = threads;
+    cfg.seed = 20250101u;
+    const SessionSketches s = simulateSessions(cfg);
+
+    cout << "=== " << s.sessions << " sessions: $" << bankroll << " bankroll, $" << bet
+         << " flat bet, up to " << maxRounds << " rounds ===\n";
+    cout << fixed << setprecision(1)
+         << "broke before the end: " << 100.0 * s.ruined / s.sessions << "%\n\n";
+    cout << setw(6) << "pct" << setw(14) << "End($)" << setw(14) << "Hands" << setw(14) << "MaxDD($)"
+         << setw(16) << "RoundsToRuin" << "\n";
+    cout << string(6 + 14 * 3 + 16, '-') << "\n" << setprecision(0);
+    for (double p : { 1.0, 5.0, 10.0, 25.0, 50.0, 75.0, 90.0, 95.0, 99.0 }) {
+        cout << setw(5) << p << "%" << setw(14) << s.endingBankroll.quantile(p / 100)
+             << setw(14) << s.handsPlayed.quantile(p / 100) << setw(14) << s.maxDrawdown.quantile(p / 100);
+        if (s.roundsToRuin.count()) cout << setw(16) << s.roundsToRuin.quantile(p / 100) << "\n";
+        else cout << setw(16) << "-" << "\n";
+    }
+    cout << setw(6) << "max" << setw(14) << s.endingBankroll.max() << setw(14) << s.handsPlayed.max()
+         << setw(14) << s.maxDrawdown.max();
+    if (s.roundsToRuin.count()) cout << setw(16) << s.roundsToRuin.max() << "\n";
+    else cout << setw(16) << "-" << "\n";
+    cout << "\nsketch memory: " << s.memoryBytes() / 1024 << " KiB (" << cfg.shards << " shards merged)\n";
+    return 0;
+}
@@ -0,0 +1,55 @@
+#ifndef SESSIONS_H
+#define SESSIONS_H
+
+#include "player.h"
+#include "sketch.h"
+
+/**
+ * Session population simulation
+ * - Simulated players each sit down with `bankroll` and flat-bet `bet`
+ *   with basic strategy (doubles and splits included) until they are
+ *   broke or have played `maxRounds` rounds; `seatsPerTable` share a table.
+ * - When a session ends, the player's ending bankroll, hands played and
+ *   largest drawdown (Player's bankroll path) go into quantile sketches.
+ *   Sessions that end broke also add the number of rounds they lasted to
+ *   roundsToRuin, so capped sessions don't dilute it.
+ * - Sessions are split into `shards` fixed slices, each with its own shoe
+ *   (seeded from seed + shard) and its own sketches. Worker threads take
+ *   whole shards; the shard sketches are merged in shard order, so the
+ *   report doesn't depend on the thread count.
+ */
+struct SessionSimConfig {
+    long long sessions = 10000;
+    int bankroll = 1000;
+    int bet = 10;
+    int maxRounds = 1000;
+    int seatsPerTable = 5;
+    int decks = 6;
+    int shards = 64;
+    int threads = 0;                // 0 = all cores
+    unsigned int seed = 1;
+};
+
+struct SessionSketches {
+    QuantileSketch endingBankroll;
+    QuantileSketch handsPlayed;
+    QuantileSketch maxDrawdown;
+    QuantileSketch roundsToRuin;    // rounds played, ruined sessions only
+    long long sessions = 0;
+    long long ruined = 0;           // ended broke
+
+    explicit SessionSketches(uint64_t seed = 1)
+        : endingBankroll(200, seed), handsPlayed(200, seed + 1), maxDrawdown(200, seed + 2),
+          roundsToRuin(200, seed + 3) {}
+
+    void record(const Player& p, int roundsPlayed);
+    void merge(const SessionSketches& other);
+    size_t memoryBytes() const;
+};
+
+SessionSketches simulateSessions(const SessionSimConfig& cfg);
+
+// Driver mode "sim-sessions [sessions] [bankroll] [bet] [max rounds] [threads]".
+int runSessionTool(long long sessions, int bankroll, int bet, int maxRounds, int threads);
+
+#endif // SESSIONS_H
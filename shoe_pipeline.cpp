@@ -0,0 +1,107 @@
+/*
+ * ShoePipeline Implementation
+ * ---------------------------
+ * Ring protocol (SPSC):
+ *  - producer fills ring[tail & mask] then publishes with tail.store(release)
+ *  - consumer reads ring[head & mask] after tail.load(acquire), swaps the
+ *    cards out, then frees the slot with head.store(release)
+ * The only lock is the producer's sleep when the ring is full; the
+ * consumer just pokes the condition variable after freeing a slot.
+ *
+ * Restart: the consumer bumps the generation in `restart` along with the
+ * shoe to continue from; the producer picks it up before its next build.
+ * A slot built under an older generation is stale whatever its index.
+ */
+
+#include "shoe_pipeline.h"
+#include <chrono>
+
+static size_t roundUpPow2(size_t n) {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+/**
+ * ShoePipeline(deck, depth)
+ * -------------------------
+ * Starts producing right after the deck's current shoe.
+ */
+ShoePipeline::ShoePipeline(const Deck& deck, size_t depth)
+    : seed(deck.getSeed()), decks(deck.deckCount()),
+      ring(roundUpPow2(depth < 1 ? 1 : depth)), mask(ring.size() - 1),
+      nextIndex(deck.shuffleCount() + 1) {
+    for (Slot& s : ring) s.cards.reserve(deck.shoeSize());
+    producer = std::thread(&ShoePipeline::run, this);
+}
+
+ShoePipeline::~ShoePipeline() {
+    stopping.store(true, std::memory_order_release);
+    wake.notify_one();
+    if (producer.joinable()) producer.join();
+}
+
+/**
+ * run()
+ * -----
+ * Producer loop: build the next shoe into a free slot, publish it, and
+ * sleep (bounded wait) while the ring is full.
+ */
+void ShoePipeline::run() {
+    while (!stopping.load(std::memory_order_acquire)) {
+        const uint64_t r = restart.load(std::memory_order_acquire);
+        if (static_cast<uint32_t>(r >> 32) != producerGeneration) {
+            producerGeneration = static_cast<uint32_t>(r >> 32);
+            nextIndex = static_cast<int>(static_cast<uint32_t>(r));
+        }
+        const size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == ring.size()) {
+            std::unique_lock<std::mutex> lk(sleepLock);
+            wake.wait_for(lk, std::chrono::milliseconds(5));
+            continue;
+        }
+        Slot& s = ring[t & mask];
+        Deck::buildShoe(s.cards, seed, decks, nextIndex);
+        s.index = nextIndex++;
+        s.generation = producerGeneration;
+        tail.store(t + 1, std::memory_order_release);
+    }
+}
+
+/**
+ * takeShoe(out, shoeIndex)
+ * ------------------------
+ * Drops stale shoes (ones the Deck already replaced with an in-place
+ * shuffle, or built before a restart), then swaps in shoe #shoeIndex if it
+ * is at the front. A front shoe past #shoeIndex means the Deck went back:
+ * everything queued is dropped and the producer restarts at shoeIndex + 1.
+ */
+bool ShoePipeline::takeShoe(std::vector<uint8_t>& out, int shoeIndex) {
+    size_t h = head.load(std::memory_order_relaxed);
+    size_t t;
+    while (h != (t = tail.load(std::memory_order_acquire))) {
+        Slot& s = ring[h & mask];
+        if (s.generation != consumerGeneration || s.index < shoeIndex) {   // stale: skip it
+            head.store(++h, std::memory_order_release);
+            wake.notify_one();
+            continue;
+        }
+        if (s.index > shoeIndex) {
+            head.store(t, std::memory_order_release);
+            ++consumerGeneration;
+            restart.store(static_cast<uint64_t>(consumerGeneration) << 32
+                | static_cast<uint32_t>(shoeIndex + 1), std::memory_order_release);
+            wake.notify_one();
+            return false;
+        }
+        out.swap(s.cards);
+        head.store(h + 1, std::memory_order_release);
+        wake.notify_one();
+        return true;
+    }
+    return false;
+}
+
+size_t ShoePipeline::readyCount() const {
+    return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+}
@@ -0,0 +1,69 @@
+#ifndef SHOE_PIPELINE_H
+#define SHOE_PIPELINE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "deck.h"
+
+/**
+ * ShoePipeline
+ * - Background producer that builds and shuffles upcoming shoes for one
+ *   Deck, so Deck::deal() never pays for a reshuffle on the hot path.
+ * - Shoes go into a bounded single-producer/single-consumer ring. Taking a
+ *   shoe is lock-free and swaps vectors in O(1); the consumer's spent
+ *   vector goes back into the slot, so steady state allocates nothing.
+ * - Shoes are built with Deck::buildShoe(seed, decks, index), so they are
+ *   identical to what an in-place shuffle would have produced.
+ * - If the Deck jumps back (Deck::loadShoe) the queued shoes are all past
+ *   the one it wants: takeShoe drops them and restarts the producer right
+ *   after the requested shoe, which the Deck builds in place meanwhile.
+ *
+ * Usage:
+ *   Deck deck(seed, 8);
+ *   ShoePipeline pipe(deck);      // declare after the deck
+ *   deck.attachPipeline(&pipe);
+ */
+class ShoePipeline {
+public:
+    explicit ShoePipeline(const Deck& deck, size_t depth = 4);
+    ~ShoePipeline();
+    ShoePipeline(const ShoePipeline&) = delete;
+    ShoePipeline& operator=(const ShoePipeline&) = delete;
+
+    // Consumer side (the Deck's thread). Swaps shoe #shoeIndex into `out`;
+    // false if that shoe isn't ready yet (or the Deck went back and the
+    // producer was restarted). Never blocks.
+    bool takeShoe(std::vector<uint8_t>& out, int shoeIndex);
+
+    size_t readyCount() const;
+
+private:
+    struct Slot {
+        std::vector<uint8_t> cards;
+        int index = 0;
+        uint32_t generation = 0;     // producer restart the shoe was built under
+    };
+
+    const unsigned int seed;
+    const int decks;
+    std::vector<Slot> ring;          // capacity = power of two
+    const size_t mask;
+    std::atomic<size_t> head{ 0 };   // next slot to consume (consumer writes)
+    std::atomic<size_t> tail{ 0 };   // next slot to fill (producer writes)
+    std::atomic<bool> stopping{ false };
+    std::atomic<uint64_t> restart{ 0 };  // generation << 32 | first shoe (consumer writes)
+    uint32_t consumerGeneration = 0; // consumer-only
+    uint32_t producerGeneration = 0; // producer-only
+    int nextIndex;                   // producer-only
+
+    std::mutex sleepLock;            // only the producer waits on this
+    std::condition_variable wake;
+    std::thread producer;
+
+    void run();
+};
+
+#endif // SHOE_PIPELINE_H
@@ -0,0 +1,179 @@
+/*
+ * Side Bets Implementation
+ * ------------------------
+ * The evaluators are inline in sidebet.h; this file holds the house-edge
+ * tools:
+ *  - simulateSideBets: seeded shoes dealt to the end, one Deck per thread
+ *  - exactSideBets:    full enumeration over one shoe composition
+ * With no cut card every opening window of a shuffled shoe is equally
+ * likely, so the simulation converges on the exact numbers.
+ */
+
+#include "sidebet.h"
+#include "deck.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+const char* sideBetName(SideBet bet) {
+    switch (bet) {
+    case PerfectPairs: return "Perfect Pairs";
+    case TwentyOnePlusThree: return "21+3";
+    case LuckyLadies: return "Lucky Ladies";
+    default: return "?";
+    }
+}
+
+void SideBetEdge::merge(const SideBetEdge& other) {
+    hands += other.hands;
+    for (int i = 0; i < SideBetCount; ++i) {
+        hits[i] += other.hits[i];
+        units[i] += other.units[i];
+    }
+}
+
+// Adds one hand's payout (0 = lost the unit stake)
+static inline void score(SideBetEdge& e, SideBet bet, int payout) {
+    if (payout) {
+        ++e.hits[bet];
+        e.units[bet] += payout;
+    }
+    else {
+        e.units[bet] -= 1.0;
+    }
+}
+
+/**
+ * simulateSideBets(seed, decks, rounds, threads)
+ * ----------------------------------------------
+ * Thread t deals from its own Deck seeded with shoeSeed(seed, t), in the
+ * usual order: player, dealer up, player, dealer hole.
+ */
+SideBetEdge simulateSideBets(unsigned int seed, int decks, long long rounds, int threads) {
+    size_t n = threads > 0 ? static_cast<size_t>(threads) : thread::hardware_concurrency();
+    if (n == 0) n = 1;
+    if (rounds < static_cast<long long>(n)) n = rounds > 0 ? static_cast<size_t>(rounds) : 1;
+
+    vector<SideBetEdge> partial(n);
+    vector<thread> workers;
+    for (size_t t = 0; t < n; ++t) {
+        const long long share = rounds / static_cast<long long>(n)
+            + (static_cast<long long>(t) < rounds % static_cast<long long>(n) ? 1 : 0);
+        workers.emplace_back([&partial, t, share, seed, decks]() {
+            Deck deck(Deck::shoeSeed(seed, static_cast<int>(t)), decks);
+            SideBetEdge e;
+            for (long long r = 0; r < share; ++r) {
+                const uint8_t p1 = deck.dealCard();
+                const uint8_t up = deck.dealCard();
+                const uint8_t p2 = deck.dealCard();
+                const uint8_t hole = deck.dealCard();
+                score(e, PerfectPairs, perfectPairsPayout(p1, p2));
+                score(e, TwentyOnePlusThree, twentyOnePlusThreePayout(p1, p2, up));
+                score(e, LuckyLadies, luckyLadiesPayout(p1, p2, up, hole));
+            }
+            e.hands = share;
+            partial[t] = e;
+        });
+    }
+    for (thread& w : workers) w.join();
+
+    SideBetEdge total;
+    for (const SideBetEdge& e : partial) total.merge(e);
+    return total;
+}
+
+/**
+ * exactSideBets(decks)
+ * --------------------
+ * Walks every ordered (player, player, dealer up) triple of the 52 card
+ * codes, weighted by the number of ways to draw it. The hole card only
+ * matters for a Q-hearts pair, so only those triples look at it.
+ */
+SideBetEdge exactSideBets(int decks) {
+    decks = max(decks, 1);
+    const long long total = 52LL * decks;
+    vector<uint8_t> codes;
+    for (int suit = 0; suit < 4; ++suit)
+        for (int rank = 0; rank < 13; ++rank) codes.push_back(card::make(rank, suit));
+
+    int left[64] = {};
+    for (uint8_t c : codes) left[c] = decks;
+
+    double units[SideBetCount] = {};
+    double hits[SideBetCount] = {};
+    auto add = [&](SideBet bet, int payout, double w) {
+        if (payout) { hits[bet] += w; units[bet] += w * payout; }
+        else units[bet] -= w;
+    };
+
+    for (uint8_t a : codes) {
+        const double wa = left[a]--;
+        for (uint8_t b : codes) {
+            if (!left[b]) continue;
+            const double wab = wa * left[b]--;
+            for (uint8_t up : codes) {
+                if (!left[up]) continue;
+                const double wabu = wab * left[up]--;
+                const double w = wabu * static_cast<double>(total - 3);  // any hole card
+                add(PerfectPairs, perfectPairsPayout(a, b), w);
+                add(TwentyOnePlusThree, twentyOnePlusThreePayout(a, b, up), w);
+                if (card::value(a) + card::value(b) != 20 || a != b || a != card::make(card::Queen, card::Hearts)) {
+                    add(LuckyLadies, luckyLadiesPayout(a, b, up, up), w);   // hole card irrelevant
+                }
+                else {
+                    for (uint8_t hole : codes) {
+                        if (left[hole]) add(LuckyLadies, luckyLadiesPayout(a, b, up, hole), wabu * left[hole]);
+                    }
+                }
+                ++left[up];
+            }
+            ++left[b];
+        }
+        ++left[a];
+    }
+
+    SideBetEdge e;
+    e.hands = total * (total - 1) * (total - 2) * (total - 3);
+    for (int i = 0; i < SideBetCount; ++i) {
+        e.hits[i] = static_cast<long long>(hits[i] + 0.5);
+        e.units[i] = units[i];
+    }
+    return e;
+}
+
+/**
+ * runSideBetSim(rounds, decks, threads)
+ * -------------------------------------
+ * Prints exact and simulated house edge for each side bet, plus the
+ * simulation throughput.
+ */
+int runSideBetSim(long long rounds, int decks, int threads) {
+    if (rounds <= 0 || decks <= 0) {
+        cout << "usage: sim-sidebets [rounds] [decks] [threads]\n";
+        return 1;
+    }
+    const SideBetEdge exact = exactSideBets(decks);
+
+    const auto t0 = chrono::steady_clock::now();
+    const SideBetEdge sim = simulateSideBets(20250101u, decks, rounds, threads);
+    const double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+    cout << "=== Side bets: " << decks << " deck(s), " << sim.hands << " simulated hands ===\n";
+    cout << left << setw(16) << "Bet" << right << setw(12) << "Exact edge" << setw(12) << "Sim edge"
+         << setw(12) << "Hit rate" << "\n";
+    cout << fixed;
+    for (int i = 0; i < SideBetCount; ++i) {
+        const SideBet bet = static_cast<SideBet>(i);
+        cout << left << setw(16) << sideBetName(bet) << right
+             << setw(11) << setprecision(3) << exact.houseEdge(bet) * 100 << "%"
+             << setw(11) << sim.houseEdge(bet) * 100 << "%"
+             << setw(11) << (sim.hands ? 100.0 * sim.hits[i] / sim.hands : 0.0) << "%\n";
+    }
+    cout << setprecision(1) << (secs > 0 ? sim.hands / secs / 1e6 : 0.0) << " M hands/sec\n";
+    return 0;
+}
@@ -0,0 +1,81 @@
+#ifndef SIDEBET_H
+#define SIDEBET_H
+
+#include <cstdint>
+#include "card.h"
+
+/**
+ * Side bets
+ * - Evaluated on the opening cards (see card.h for the encoding); each
+ *   evaluator returns the payout in "to 1" units, or 0 if the bet loses.
+ * - Rank/suit/color tests are XORs and masks on the card bytes and the
+ *   21+3 straight test is one rank bitmask, so a hand costs a few
+ *   instructions and no branches on card tables.
+ *
+ * Paytables:
+ *  Perfect Pairs (player's two cards)
+ *    perfect pair (same suit) 25, colored pair 12, mixed pair 6
+ *  21+3 (player's two cards + dealer up card, as a poker hand)
+ *    suited trips 100, straight flush 40, trips 30, straight 10, flush 5
+ *  Lucky Ladies (player's two cards total 20)
+ *    Q-hearts pair with dealer blackjack 1000, Q-hearts pair 125,
+ *    matched 20 (same rank and suit) 19, suited 20 9, any 20 4
+ */
+enum SideBet { PerfectPairs = 0, TwentyOnePlusThree, LuckyLadies, SideBetCount };
+
+const char* sideBetName(SideBet bet);
+
+inline int perfectPairsPayout(uint8_t a, uint8_t b) {
+    const unsigned x = a ^ b;
+    if (x & card::kRankMask) return 0;     // ranks differ
+    if (x == 0) return 25;                 // same suit
+    return (x & card::kRedBit) ? 6 : 12;   // different color : same color
+}
+
+inline int twentyOnePlusThreePayout(uint8_t a, uint8_t b, uint8_t up) {
+    const unsigned ranks = (1u << card::rank(a)) | (1u << card::rank(b)) | (1u << card::rank(up));
+    const bool flush = (((a ^ b) | (a ^ up)) & card::kSuitMask) == 0;
+    if ((ranks & (ranks - 1)) == 0) return flush ? 100 : 30;          // one rank: trips
+    const unsigned low = ranks & (0u - ranks);
+    const bool straight = ranks / low == 7u                           // three in a row
+        || ranks == ((1u << card::Ace) | (1u << card::Queen) | (1u << card::King));
+    if (straight) return flush ? 40 : 10;
+    return flush ? 5 : 0;
+}
+
+inline int luckyLadiesPayout(uint8_t a, uint8_t b, uint8_t up, uint8_t hole) {
+    if (card::value(a) + card::value(b) != 20) return 0;
+    constexpr uint8_t queenHearts = card::make(card::Queen, card::Hearts);
+    if (a == queenHearts && b == queenHearts)
+        return card::value(up) + card::value(hole) == 21 ? 1000 : 125;
+    if (a == b) return 19;                                    // matched
+    return ((a ^ b) & card::kSuitMask) == 0 ? 9 : 4;          // suited : any
+}
+
+/**
+ * SideBetEdge
+ * - Results for each side bet: hands evaluated, hands paid, and the total
+ *   return per unit staked (payouts minus losing stakes).
+ * - houseEdge() is the casino's expected take per unit bet.
+ */
+struct SideBetEdge {
+    long long hands = 0;
+    long long hits[SideBetCount] = {};
+    double units[SideBetCount] = {};    // net player result in units
+
+    double houseEdge(SideBet bet) const { return hands ? -units[bet] / static_cast<double>(hands) : 0.0; }
+    void merge(const SideBetEdge& other);
+};
+
+// Deals `rounds` openings (player, dealer up, player, dealer hole) from
+// seeded `decks`-deck shoes split across threads (0 = all cores).
+SideBetEdge simulateSideBets(unsigned int seed, int decks, long long rounds, int threads = 0);
+
+// Exact edges for a full `decks`-deck shoe: every ordered 4-card opening,
+// weighted by how many ways the shoe can deal it.
+SideBetEdge exactSideBets(int decks);
+
+// Driver mode "sim-sidebets [rounds] [decks] [threads]": prints both.
+int runSideBetSim(long long rounds, int decks, int threads);
+
+#endif // SIDEBET_H
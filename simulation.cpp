@@ -0,0 +1,354 @@
+/*
+ * Simulation Implementation
+ * -------------------------
+ * runPairedSimulation: each worker owns two complete tables (deck, table,
+ * seat) - one per variant - and walks the shoe numbers t, t + threads, ...
+ * of a batch.
+ * For every shoe both decks load the same cards, both tables play the same
+ * number of rounds with Table::playRounds, and the per-round results are
+ * summed into one sample per variant.
+ *
+ * All three simulations run through runShoeBatches: workers split each
+ * batch of shoes, and the batch is folded into the totals before the next
+ * one starts (per-shoe samples in shoe order, so the sums don't depend on
+ * the thread count or on where a run was resumed).
+ *
+ * Workers are pinned (numa.h) and build their tables and accumulators
+ * themselves, so that memory sits on their own node; a worker's results
+ * are moved into the shared array once, when it is done.
+ */
+
+#include "simulation.h"
+#include "deck.h"
+#include "player.h"
+#include "strategy.h"
+#include "table.h"
+#include "numa.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+// One variant's table: its own deck (same seed as the other variant) and
+// a single flat-betting seat with a bankroll that can't run out.
+struct SimTable {
+    Deck deck;
+    Table table;
+    Player seat;
+    vector<RoundResult> results;
+
+    SimTable(const RuleSet& rules, unsigned int seed, int decks, int rounds)
+        : deck(seed, decks), table(deck), seat("sim", 1 << 30), results(rounds) {
+        table.setHitSoft17(rules.hitSoft17);
+        seat.setBet(1);
+        table.addPlayer(&seat);
+    }
+
+    // plays shoe #shoeIndex (or its mirrored twin) into `results`
+    template <class Policy>
+    void play(int shoeIndex, Policy& policy, bool mirrored = false) {
+        deck.loadShoe(shoeIndex, mirrored);
+        table.playRounds(results.size(), policy, results.data());
+    }
+
+    // units won per round on shoe #shoeIndex
+    double playShoe(int shoeIndex, BasicStrategy& policy, bool mirrored = false) {
+        play(shoeIndex, policy, mirrored);
+        long long net = 0;
+        for (const RoundResult& r : results) net += r.net;
+        return static_cast<double>(net) / results.size();
+    }
+};
+
+size_t workerCount(int threads, long long items) {
+    size_t n = threads > 0 ? static_cast<size_t>(threads) : thread::hardware_concurrency();
+    if (n == 0) n = 1;
+    if (items < static_cast<long long>(n)) n = items > 0 ? static_cast<size_t>(items) : 1;
+    return n;
+}
+
+// runs work(t, n) on n pinned worker threads for the shoes first..last;
+// worker t plays shoes first + t, first + t + n, ...
+template <class Work>
+size_t splitShoes(int threads, long long first, long long last, Work work) {
+    const size_t n = workerCount(threads, last - first + 1);
+    numa::runPinned(n, [&work, n](size_t t) { work(t, n); });
+    return n;
+}
+
+constexpr long long kSampleBatchShoes = 4096;
+
+uint64_t settingsFingerprint(const RuleSet& rules, unsigned int seed, int decks) {
+    return Checkpoint::fingerprint({ seed, static_cast<uint64_t>(decks), rules.hitSoft17 ? 1u : 0u });
+}
+
+void saveDistribution(Checkpoint& c, const OutcomeDistribution& d) {
+    c.write(d.values);
+    c.write(d.counts);
+    c.write(d.total);
+}
+
+bool loadDistribution(Checkpoint& c, OutcomeDistribution& d) {
+    OutcomeDistribution in;
+    if (!c.read(in.values) || !c.read(in.counts) || !c.read(in.total) || in.values.size() != in.counts.size())
+        return false;
+    d = in;
+    return true;
+}
+
+} // namespace
+
+// ~5.4 cards per one-seat round; budget 6 so rounds stay in the shoe
+int roundsPerShoe(int decks, double penetration) {
+    return max(1, static_cast<int>(decks * 52 * penetration / 6));
+}
+
+void OutcomeDistribution::add(int units, long long n) {
+    auto it = lower_bound(values.begin(), values.end(), units);
+    const size_t i = static_cast<size_t>(it - values.begin());
+    if (it == values.end() || *it != units) {
+        values.insert(it, units);
+        counts.insert(counts.begin() + i, 0);
+    }
+    counts[i] += n;
+    total += n;
+}
+
+void OutcomeDistribution::merge(const OutcomeDistribution& o) {
+    for (size_t i = 0; i < o.values.size(); ++i) add(o.values[i], o.counts[i]);
+}
+
+double OutcomeDistribution::mean() const {
+    double m = 0.0;
+    for (size_t i = 0; i < values.size(); ++i) m += probability(i) * values[i];
+    return m;
+}
+
+double OutcomeDistribution::variance() const {
+    const double m = mean();
+    double v = 0.0;
+    for (size_t i = 0; i < values.size(); ++i) v += probability(i) * (values[i] - m) * (values[i] - m);
+    return v;
+}
+
+/**
+ * sampleOutcomes(rules, seed, decks, shoes, threads, checkpoint)
+ * --------------------------------------------------------------
+ * Same shoe split as runPairedSimulation, one table per worker.
+ */
+OutcomeDistribution sampleOutcomes(const RuleSet& rules, unsigned int seed, int decks,
+    long long shoes, int threads, const CheckpointConfig& checkpoint) {
+    decks = max(decks, 1);
+    const int rounds = roundsPerShoe(decks, 0.75);
+
+    OutcomeDistribution total;
+    runShoeBatches(checkpoint, CheckpointOutcomes, settingsFingerprint(rules, seed, decks), shoes, kSampleBatchShoes,
+        [&](Checkpoint& c) { saveDistribution(c, total); },
+        [&](Checkpoint& c) { return loadDistribution(c, total) && c.atEnd(); },
+        [&](long long first, long long last) {
+            vector<OutcomeDistribution> partial(workerCount(threads, last - first + 1));
+            splitShoes(threads, first, last, [&](size_t t, size_t n) {
+                SimTable sim(rules, seed, decks, rounds);
+                BasicStrategy policy;
+                OutcomeDistribution local;
+                for (long long k = first + static_cast<long long>(t); k <= last; k += static_cast<long long>(n)) {
+                    sim.play(static_cast<int>(k), policy);
+                    for (const RoundResult& r : sim.results) local.add(r.net);
+                }
+                partial[t] = move(local);
+            });
+            for (const OutcomeDistribution& d : partial) total.merge(d);
+        });
+    return total;
+}
+
+size_t CountOutcomes::bucket(double trueCount) {
+    const int tc = static_cast<int>(floor(trueCount));
+    return static_cast<size_t>(min(max(tc, kMinCount), kMaxCount) - kMinCount);
+}
+
+long long CountOutcomes::rounds() const {
+    long long n = 0;
+    for (const OutcomeDistribution& d : byCount) n += d.total;
+    return n;
+}
+
+double CountOutcomes::frequency(int trueCount) const {
+    const long long n = rounds();
+    return n ? static_cast<double>(at(trueCount).total) / n : 0.0;
+}
+
+void CountOutcomes::merge(const CountOutcomes& o) {
+    for (size_t i = 0; i < byCount.size(); ++i) byCount[i].merge(o.byCount[i]);
+}
+
+/**
+ * sampleCountOutcomes(rules, seed, decks, shoes, threads, checkpoint)
+ * -------------------------------------------------------------------
+ * Like sampleOutcomes, but the seat counts cards and plays its index
+ * hands; rounds are played one at a time so the true count can be read
+ * before each deal.
+ */
+CountOutcomes sampleCountOutcomes(const RuleSet& rules, unsigned int seed, int decks,
+    long long shoes, int threads, const CheckpointConfig& checkpoint) {
+    decks = max(decks, 1);
+    const int rounds = roundsPerShoe(decks, 0.75);
+
+    CountOutcomes total;
+    runShoeBatches(checkpoint, CheckpointCountOutcomes, settingsFingerprint(rules, seed, decks), shoes, kSampleBatchShoes,
+        [&](Checkpoint& c) { for (const OutcomeDistribution& d : total.byCount) saveDistribution(c, d); },
+        [&](Checkpoint& c) {
+            CountOutcomes in;
+            for (OutcomeDistribution& d : in.byCount) if (!loadDistribution(c, d)) return false;
+            if (!c.atEnd()) return false;
+            total = in;
+            return true;
+        },
+        [&](long long first, long long last) {
+            vector<CountOutcomes> partial(workerCount(threads, last - first + 1));
+            splitShoes(threads, first, last, [&](size_t t, size_t n) {
+                SimTable sim(rules, seed, decks, 1);
+                HiLoCounting policy;
+                RoundResult r;
+                CountOutcomes local;
+                for (long long k = first + static_cast<long long>(t); k <= last; k += static_cast<long long>(n)) {
+                    sim.deck.loadShoe(static_cast<int>(k));
+                    for (int i = 0; i < rounds; ++i) {
+                        const bool fresh = policy.shoeId != sim.deck.shuffleCount();
+                        const double tc = fresh ? 0.0 : policy.trueCount(sim.deck.cardsRemaining());
+                        sim.table.playRounds(1, policy, &r);
+                        local.byCount[CountOutcomes::bucket(tc)].add(r.net);
+                    }
+                }
+                partial[t] = move(local);
+            });
+            for (const CountOutcomes& c : partial) total.merge(c);
+        });
+    return total;
+}
+
+/**
+ * runPairedSimulation(cfg)
+ * ------------------------
+ * Shoes are numbered from 1; within a batch worker t plays shoes
+ * first+t, first+t+threads, ... into its own sample list, and the batch's
+ * samples are then added in shoe order. Antithetic runs play every shoe
+ * plain and mirrored; the sample is the average of the two, and the plain
+ * shoe alone is kept as well to measure what the mirroring bought.
+ */
+PairedSimResult runPairedSimulation(const PairedSimConfig& cfg) {
+    const int decks = max(cfg.decks, 1);
+    const int rounds = cfg.roundsPerShoe > 0 ? cfg.roundsPerShoe : roundsPerShoe(decks, cfg.penetration);
+    const uint64_t fingerprint = Checkpoint::fingerprint({ cfg.seed, static_cast<uint64_t>(decks),
+        static_cast<uint64_t>(rounds),
+        cfg.a.hitSoft17 ? 1u : 0u, cfg.b.hitSoft17 ? 1u : 0u, cfg.antithetic ? 1u : 0u });
+
+    struct Sample { double a, b, aPlain, bPlain; };
+    PairedSimResult total;
+    vector<vector<Sample>> samples;   // [worker][i]: shoe first + worker + i * workers
+    total.checkpoint = runShoeBatches(cfg.checkpoint, CheckpointPairedSim, fingerprint, cfg.shoes, cfg.batchShoes,
+        [&](Checkpoint& c) {
+            c.write(total.a); c.write(total.b); c.write(total.diff);
+            c.write(total.aPlain); c.write(total.diffPlain);
+        },
+        [&](Checkpoint& c) {
+            RunningStat a, b, diff, aPlain, diffPlain;
+            if (!c.read(a) || !c.read(b) || !c.read(diff) || !c.read(aPlain) || !c.read(diffPlain)
+                || !c.atEnd()) return false;
+            total.a = a;
+            total.b = b;
+            total.diff = diff;
+            total.aPlain = aPlain;
+            total.diffPlain = diffPlain;
+            return true;
+        },
+        [&](long long first, long long last) {
+            const size_t workers = workerCount(cfg.threads, last - first + 1);
+            samples.assign(workers, vector<Sample>());
+            splitShoes(cfg.threads, first, last, [&](size_t t, size_t n) {
+                SimTable ta(cfg.a, cfg.seed, decks, rounds);
+                SimTable tb(cfg.b, cfg.seed, decks, rounds);
+                BasicStrategy policy;
+                vector<Sample> local;
+                for (long long k = first + static_cast<long long>(t); k <= last; k += static_cast<long long>(n)) {
+                    const int shoe = static_cast<int>(k);
+                    Sample s;
+                    s.a = s.aPlain = ta.playShoe(shoe, policy);
+                    s.b = s.bPlain = tb.playShoe(shoe, policy);
+                    if (cfg.antithetic) {
+                        s.a = (s.a + ta.playShoe(shoe, policy, true)) / 2;
+                        s.b = (s.b + tb.playShoe(shoe, policy, true)) / 2;
+                    }
+                    local.push_back(s);
+                }
+                samples[t] = move(local);
+            });
+            for (long long k = first; k <= last; ++k) {
+                const size_t w = static_cast<size_t>(k - first) % workers;
+                const Sample& s = samples[w][static_cast<size_t>(k - first) / workers];
+                total.a.add(s.a);
+                total.b.add(s.b);
+                total.diff.add(s.a - s.b);
+                if (cfg.antithetic) {
+                    total.aPlain.add(s.aPlain);
+                    total.diffPlain.add(s.aPlain - s.bPlain);
+                }
+            }
+        });
+    total.rounds = total.a.n * rounds * (cfg.antithetic ? 2 : 1);
+    return total;
+}
+
+/**
+ * runRuleComparison(shoes, decks, threads, antithetic, checkpointPath)
+ * --------------------------------------------------------------------
+ * Stand on soft 17 (A) vs hit soft 17 (B), printed as player edge in
+ * percent with 95% confidence intervals. With a checkpoint file the run
+ * saves every 30 s and a rerun resumes where it stopped.
+ */
+int runRuleComparison(long long shoes, int decks, int threads, bool antithetic, const string& checkpointPath) {
+    if (shoes <= 0 || decks <= 0) {
+        cout << "usage: sim-rules [shoes] [decks] [threads] [antithetic 0/1] [checkpoint file]\n";
+        return 1;
+    }
+    PairedSimConfig cfg;
+    cfg.a.hitSoft17 = false;
+    cfg.b.hitSoft17 = true;
+    cfg.seed = 20250101u;
+    cfg.decks = decks;
+    cfg.shoes = shoes;
+    cfg.threads = threads;
+    cfg.antithetic = antithetic;
+    cfg.checkpoint.path = checkpointPath;
+    const PairedSimResult r = runPairedSimulation(cfg);
+
+    // CI the same rounds would give if the variants were run independently
+    const double independentCi = r.a.n ? 1.96 * sqrt((r.a.variance() + r.b.variance()) / r.a.n) : 0.0;
+
+    cout << fixed << setprecision(3);
+    cout << "=== S17 vs H17: " << decks << " deck(s), " << r.a.n << " shoes"
+         << (antithetic ? " (+ mirrored)" : "") << ", " << r.rounds << " rounds per variant ===\n";
+    cout << "S17 player edge:  " << setw(8) << r.a.mean() * 100 << "% +/- " << r.a.ci95() * 100 << "%\n";
+    cout << "H17 player edge:  " << setw(8) << r.b.mean() * 100 << "% +/- " << r.b.ci95() * 100 << "%\n";
+    cout << "S17 - H17:        " << setw(8) << r.diff.mean() * 100 << "% +/- " << r.diff.ci95() * 100 << "%\n";
+    cout << "independent runs: " << setw(8) << "" << "  +/- " << independentCi * 100 << "%\n";
+    if (!checkpointPath.empty()) {
+        const CheckpointStats& ck = r.checkpoint;
+        cout << "checkpoint: resumed at shoe " << ck.resumedAt << ", " << ck.saves << " save(s), "
+             << ck.saveSeconds * 1000 << " ms (" << ck.overhead() * 100 << "% of run)"
+             << (ck.failedSaves ? " - could not write " + checkpointPath : string()) << "\n";
+        if (ck.aheadAt) cout << "(" << checkpointPath << " is already at shoe " << ck.aheadAt << "; left as it is)\n";
+    }
+    cout << setprecision(1) << "variance reduction: " << r.varianceReduction() << "x fewer rounds (common shoes)\n";
+    if (antithetic) {
+        cout << setprecision(2) << "antithetic shoes:   " << r.antitheticEdgeGain() << "x on the edge, "
+             << r.antitheticDiffGain() << "x on S17 - H17 (vs two independent shoes)\n";
+    }
+    return 0;
+}
@@ -0,0 +1,151 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include "checkpoint.h"
+
+/**
+ * Simulation
+ * - Offline round-level simulations of the table (bots only, nothing
+ *   printed), used to measure house edge and compare rule variants.
+ * - Work is split by shoe: shoe #k of a seed is always the same cards
+ *   (Deck::loadShoe), so results don't depend on the thread count.
+ * - Shoes are played in batches; with a CheckpointConfig path the sums are
+ *   checkpointed between batches and a rerun resumes from them (see
+ *   checkpoint.h), giving the same result as an uninterrupted run.
+ */
+
+// Rules a simulation can vary (everything the Table exposes today).
+struct RuleSet {
+    bool hitSoft17 = false;
+};
+
+// Count / mean / variance accumulator for per-sample results.
+struct RunningStat {
+    long long n = 0;
+    double sum = 0.0;
+    double sumSq = 0.0;
+
+    void add(double x) { ++n; sum += x; sumSq += x * x; }
+    void merge(const RunningStat& o) { n += o.n; sum += o.sum; sumSq += o.sumSq; }
+    double mean() const { return n ? sum / n : 0.0; }
+    double variance() const {
+        if (n < 2) return 0.0;
+        const double m = mean();
+        return (sumSq - n * m * m) / (n - 1);
+    }
+    // half width of the ~95% confidence interval on the mean
+    double ci95() const { return n ? 1.96 * std::sqrt(variance() / n) : 0.0; }
+};
+
+// One-seat rounds that fit in `penetration` of a `decks`-deck shoe.
+int roundsPerShoe(int decks, double penetration = 0.75);
+
+/**
+ * OutcomeDistribution
+ * - Empirical distribution of a seat's net result per round, in units of
+ *   the bet (today -1 / 0 / +1; kept general for doubles and splits).
+ * - values are sorted; counts[i] rounds ended with values[i].
+ */
+struct OutcomeDistribution {
+    std::vector<int> values;
+    std::vector<long long> counts;
+    long long total = 0;
+
+    void add(int units, long long n = 1);
+    void merge(const OutcomeDistribution& o);
+    double probability(size_t i) const { return total ? static_cast<double>(counts[i]) / total : 0.0; }
+    double mean() const;
+    double variance() const;
+};
+
+// Plays `shoes` shoes (one flat-betting basic-strategy seat, cfg-style
+// shoe numbering) and collects the per-round outcomes.
+OutcomeDistribution sampleOutcomes(const RuleSet& rules, unsigned int seed, int decks,
+    long long shoes, int threads = 0, const CheckpointConfig& checkpoint = CheckpointConfig());
+
+/**
+ * CountOutcomes
+ * - Outcome distributions of a Hi-Lo counting seat (HiLoCounting), split by
+ *   the floored true count at the start of each round. Counts outside
+ *   [kMinCount, kMaxCount] are clamped into the end buckets.
+ * - Simulated once and reused by anything that only changes bet sizes.
+ */
+struct CountOutcomes {
+    static constexpr int kMinCount = -4;
+    static constexpr int kMaxCount = 8;
+
+    std::vector<OutcomeDistribution> byCount =
+        std::vector<OutcomeDistribution>(kMaxCount - kMinCount + 1);
+
+    static size_t bucket(double trueCount);
+    long long rounds() const;
+    double frequency(int trueCount) const;      // share of rounds at that count
+    const OutcomeDistribution& at(int trueCount) const { return byCount[trueCount - kMinCount]; }
+    void merge(const CountOutcomes& o);
+};
+
+CountOutcomes sampleCountOutcomes(const RuleSet& rules, unsigned int seed, int decks,
+    long long shoes, int threads = 0, const CheckpointConfig& checkpoint = CheckpointConfig());
+
+/**
+ * Paired rule comparison
+ * - Variant A and variant B play the *same* shoes (common random numbers):
+ *   one flat-betting basic-strategy seat, a fixed number of rounds per shoe.
+ *   The per-shoe difference in units won per round is the sample, so most
+ *   of the card luck cancels out of the comparison.
+ * - antithetic = each shoe is also played with every rank mirrored
+ *   high<->low (card::mirror) and the two runs are averaged into one sample.
+ *   A rich shoe becomes a poor one, so the card luck of the pair partly
+ *   cancels on top of the A/B pairing.
+ */
+struct PairedSimConfig {
+    RuleSet a;
+    RuleSet b;
+    unsigned int seed = 1;
+    int decks = 6;
+    long long shoes = 10000;
+    int roundsPerShoe = 0;      // 0 = what fits in `penetration` of the shoe
+    double penetration = 0.75;
+    bool antithetic = false;
+    int threads = 0;            // 0 = all cores
+    long long batchShoes = 4096;
+    CheckpointConfig checkpoint;
+};
+
+// Per-sample results are in units per round (+ = player ahead).
+struct PairedSimResult {
+    long long rounds = 0;       // per variant
+    RunningStat a;
+    RunningStat b;
+    RunningStat diff;           // a - b
+    RunningStat aPlain;         // antithetic runs: the unmirrored shoe alone
+    RunningStat diffPlain;
+    CheckpointStats checkpoint;
+
+    // Var(a) + Var(b) over Var(a - b): how many times fewer rounds the
+    // paired run needs for the same CI as two independent runs.
+    double varianceReduction() const {
+        const double v = diff.variance();
+        return v > 0 ? (a.variance() + b.variance()) / v : 0.0;
+    }
+    // Antithetic runs: Var(plain) / 2 over Var(pair average), i.e. how many
+    // times fewer rounds than playing two independent shoes (1 = no gain).
+    static double antitheticGain(const RunningStat& plain, const RunningStat& paired) {
+        const double v = paired.variance();
+        return v > 0 ? plain.variance() / 2 / v : 0.0;
+    }
+    double antitheticEdgeGain() const { return antitheticGain(aPlain, a); }
+    double antitheticDiffGain() const { return antitheticGain(diffPlain, diff); }
+};
+
+PairedSimResult runPairedSimulation(const PairedSimConfig& cfg);
+
+// Driver mode "sim-rules [shoes] [decks] [threads] [antithetic 0/1] [checkpoint file]":
+// stand vs hit soft 17.
+int runRuleComparison(long long shoes, int decks, int threads, bool antithetic,
+    const std::string& checkpointPath = "");
+
+#endif // SIMULATION_H
@@ -0,0 +1,125 @@
+/*
+ * Quantile Sketch Implementation
+ * ------------------------------
+ * Level capacities follow KLL: the top level holds k samples and each
+ * level below holds 2/3 of the one above (at least 2), so most of the
+ * memory sits at the top where samples carry the most weight.
+ */
+
+#include "sketch.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+using namespace std;
+
+QuantileSketch::QuantileSketch(int k, uint64_t seed)
+    : k(k < 8 ? 8 : k), rng(seed ? seed : 0x9E3779B97F4A7C15ULL) {
+    setLevels(1);
+}
+
+// adds levels and recomputes every level's capacity (they shrink with depth)
+void QuantileSketch::setLevels(size_t count) {
+    levels.resize(count);
+    caps.resize(count);
+    capTotal = 0;
+    for (size_t h = 0; h < count; ++h) {
+        const double depth = static_cast<double>(count - 1 - h);
+        caps[h] = std::max<size_t>(2, static_cast<size_t>(ceil(k * pow(2.0 / 3.0, depth))));
+        capTotal += caps[h];
+    }
+}
+
+size_t QuantileSketch::memoryBytes() const {
+    size_t bytes = sizeof(*this) + levels.capacity() * sizeof(vector<double>) + caps.capacity() * sizeof(size_t);
+    for (const vector<double>& level : levels) bytes += level.capacity() * sizeof(double);
+    return bytes;
+}
+
+// xorshift64: one bit per compaction
+bool QuantileSketch::coin() {
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    return (rng >> 32) & 1;
+}
+
+void QuantileSketch::add(double x) {
+    if (n == 0) lo = hi = x;
+    lo = std::min(lo, x);
+    hi = std::max(hi, x);
+    ++n;
+    ++kept;
+    levels[0].push_back(x);
+    if (levels[0].size() >= caps[0]) compress();
+}
+
+/**
+ * compact(level)
+ * --------------
+ * Sorts the level and promotes the even- or odd-indexed half (weight
+ * doubles, so the total weight is unchanged); an odd sample out stays.
+ */
+void QuantileSketch::compact(size_t level) {
+    if (level + 1 == levels.size()) setLevels(levels.size() + 1);
+    vector<double>& from = levels[level];
+    vector<double>& to = levels[level + 1];
+    sort(from.begin(), from.end());
+    const size_t even = from.size() & ~static_cast<size_t>(1);
+    for (size_t i = coin() ? 1 : 0; i < even; i += 2) to.push_back(from[i]);
+    if (from.size() > even) from[0] = from.back();
+    from.resize(from.size() - even);
+    kept -= even / 2;
+}
+
+void QuantileSketch::compress() {
+    while (kept > capTotal || levels[0].size() >= caps[0]) {
+        size_t h = 0;
+        while (h + 1 < levels.size() && levels[h].size() < caps[h]) ++h;
+        compact(h);
+    }
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+    if (other.n == 0) return;
+    if (n == 0) { lo = other.lo; hi = other.hi; }
+    lo = std::min(lo, other.lo);
+    hi = std::max(hi, other.hi);
+    n += other.n;
+    if (levels.size() < other.levels.size()) setLevels(other.levels.size());
+    for (size_t h = 0; h < other.levels.size(); ++h)
+        levels[h].insert(levels[h].end(), other.levels[h].begin(), other.levels[h].end());
+    kept += other.kept;
+    compress();
+}
+
+/**
+ * quantile(q)
+ * -----------
+ * Smallest retained sample whose cumulative weight reaches q * count.
+ */
+double QuantileSketch::quantile(double q) const {
+    if (n == 0) return 0.0;
+    if (q <= 0.0) return lo;
+    if (q >= 1.0) return hi;
+    vector<pair<double, uint64_t>> weighted;
+    weighted.reserve(retained());
+    for (size_t h = 0; h < levels.size(); ++h)
+        for (double x : levels[h]) weighted.emplace_back(x, uint64_t(1) << h);
+    sort(weighted.begin(), weighted.end());
+    const double target = q * static_cast<double>(n);
+    uint64_t cumulative = 0;
+    for (const auto& w : weighted) {
+        cumulative += w.second;
+        if (static_cast<double>(cumulative) >= target) return w.first;
+    }
+    return hi;
+}
+
+double QuantileSketch::rank(double x) const {
+    if (n == 0) return 0.0;
+    uint64_t below = 0;
+    for (size_t h = 0; h < levels.size(); ++h)
+        for (double v : levels[h]) if (v <= x) below += uint64_t(1) << h;
+    return static_cast<double>(below) / static_cast<double>(n);
+}
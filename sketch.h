@@ -0,0 +1,53 @@
+#ifndef SKETCH_H
+#define SKETCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * QuantileSketch
+ * - KLL quantile sketch: a stack of compactors, level h holding samples of
+ *   weight 2^h. When the sketch is over capacity the lowest full level is
+ *   sorted and every other sample (random even/odd half) moves up a level.
+ * - Memory is bounded by about 3k doubles whatever the sample count; a
+ *   quantile is within roughly 1.7/k of its true rank (k = 200: ~1%).
+ * - merge() concatenates the levels and compacts, so per-thread / per-shard
+ *   sketches combine into one with the same error bound. The coin flips
+ *   come from a seeded generator, so runs are reproducible.
+ * - min() and max() are exact.
+ */
+class QuantileSketch {
+public:
+    explicit QuantileSketch(int k = 200, uint64_t seed = 1);
+
+    void add(double x);
+    void merge(const QuantileSketch& other);
+
+    double quantile(double q) const;   // q in [0, 1]
+    double rank(double x) const;       // share of samples <= x
+    uint64_t count() const { return n; }
+    double min() const { return lo; }
+    double max() const { return hi; }
+
+    size_t retained() const { return kept; }   // samples kept
+    size_t memoryBytes() const;
+
+private:
+    int k;
+    uint64_t rng;
+    uint64_t n = 0;
+    double lo = 0.0;
+    double hi = 0.0;
+    std::vector<std::vector<double>> levels;
+    std::vector<size_t> caps;          // per level, recomputed when a level is added
+    size_t capTotal = 0;
+    size_t kept = 0;
+
+    void setLevels(size_t count);
+    void compact(size_t level);
+    void compress();
+    bool coin();
+};
+
+#endif // SKETCH_H
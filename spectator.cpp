@@ -0,0 +1,290 @@
+/*
+ * Spectator Feed Implementation
+ * -----------------------------
+ * Segment names: "/<name>" for shm_open, "Local\<name>" on Windows.
+ * The producer builds the header with magic = 0 and stores the magic last,
+ * so an observer that attaches mid-create sees an invalid segment rather
+ * than a half-initialised one.
+ * Named mappings on Windows disappear with their last handle, so only the
+ * POSIX segments can outlive a crashed producer and need the pid check.
+ */
+
+#include "spectator.h"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+#ifndef _WIN32
+/**
+ * isStale(path)
+ * -------------
+ * True if the existing segment at path was left by a producer that is no
+ * longer running. A header still being built (no magic yet) gets 100 ms
+ * to appear before the segment counts as abandoned.
+ */
+bool SpectatorFeed::isStale(const string& path) {
+    const int f = shm_open(path.c_str(), O_RDONLY, 0);
+    if (f < 0) return errno == ENOENT;      // already gone
+    struct stat st;
+    void* p = MAP_FAILED;
+    if (fstat(f, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(Header))
+        p = mmap(nullptr, sizeof(Header), PROT_READ, MAP_SHARED, f, 0);
+    ::close(f);
+    if (p == MAP_FAILED) return true;       // too short to be a feed
+    const Header* h = static_cast<const Header*>(p);
+    for (int tries = 0; tries < 100 && h->magic != kMagic; ++tries)
+        this_thread::sleep_for(chrono::milliseconds(1));
+    const pid_t pid = static_cast<pid_t>(h->ownerPid);
+    const bool alive = h->magic == kMagic && pid > 0 && (kill(pid, 0) == 0 || errno == EPERM);
+    munmap(p, sizeof(Header));
+    return !alive;
+}
+#endif
+
+/**
+ * map(name, create, slotCount)
+ * ----------------------------
+ * create: size the segment for slotCount slots and map it read/write.
+ * attach: map whatever size the segment has, read-only.
+ */
+bool SpectatorFeed::map(const string& name, bool create, uint32_t slotCount) {
+    const size_t want = sizeof(Header) + static_cast<size_t>(slotCount) * sizeof(Slot);
+#ifdef _WIN32
+    const string path = "Local\\" + name;
+    if (create) {
+        mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+            static_cast<DWORD>(static_cast<uint64_t>(want) >> 32), static_cast<DWORD>(want), path.c_str());
+        if (!mapping) return false;
+        if (GetLastError() == ERROR_ALREADY_EXISTS) return false;   // a live table has the name
+        header = static_cast<Header*>(MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, want));
+        bytes = want;
+    }
+    else {
+        mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, path.c_str());
+        if (!mapping) return false;
+        header = static_cast<Header*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        MEMORY_BASIC_INFORMATION info;
+        bytes = header && VirtualQuery(header, &info, sizeof(info)) ? info.RegionSize : 0;
+    }
+    if (!header) return false;
+#else
+    const string path = "/" + name;
+    if (create) {
+        fd = shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0 && errno == EEXIST && isStale(path)) {
+            shm_unlink(path.c_str());   // left by a crashed run
+            fd = shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        }
+        if (fd < 0) return false;
+        if (ftruncate(fd, static_cast<off_t>(want)) != 0) return false;
+        bytes = want;
+    }
+    else {
+        fd = shm_open(path.c_str(), O_RDONLY, 0);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0) return false;
+        bytes = static_cast<size_t>(st.st_size);
+    }
+    if (bytes < sizeof(Header)) return false;
+    void* p = mmap(nullptr, bytes, create ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) return false;
+    header = static_cast<Header*>(p);
+#endif
+    slots = reinterpret_cast<Slot*>(reinterpret_cast<uint8_t*>(header) + sizeof(Header));
+    return true;
+}
+
+/**
+ * create(name, slots)
+ * -------------------
+ * New zero-filled segment; every slot sequence starts at 0 (nothing written).
+ */
+bool SpectatorFeed::create(const string& name, uint32_t slotCount) {
+    close();
+    uint32_t n = 1;
+    while (n < slotCount && n < (1u << 20)) n <<= 1;
+    if (!map(name, true, n)) { close(); return false; }
+    owner = true;                   // the name is ours from here on
+    segment = name;
+
+    header->version = kVersion;
+#ifdef _WIN32
+    header->ownerPid = static_cast<uint32_t>(GetCurrentProcessId());
+#else
+    header->ownerPid = static_cast<uint32_t>(getpid());
+#endif
+    header->slotCount = n;
+    header->frameSize = sizeof(SpectatorFrame);
+    header->head.store(0, memory_order_relaxed);
+    for (uint32_t i = 0; i < n; ++i) slots[i].seq.store(0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    header->magic = kMagic;
+    mask = n - 1;
+    return true;
+}
+
+/**
+ * attach(name)
+ * ------------
+ * Fails unless the segment is a finished feed of this version and frame
+ * layout, big enough for the slot count it claims.
+ */
+bool SpectatorFeed::attach(const string& name) {
+    close();
+    if (!map(name, false, 0)) { close(); return false; }
+    const uint32_t n = header->slotCount;
+    const bool ok = header->magic == kMagic && header->version == kVersion
+        && header->frameSize == sizeof(SpectatorFrame) && n > 0 && (n & (n - 1)) == 0
+        && bytes >= sizeof(Header) + static_cast<size_t>(n) * sizeof(Slot);
+    if (!ok) { close(); return false; }
+    atomic_thread_fence(memory_order_acquire);
+    mask = n - 1;
+    return true;
+}
+
+void SpectatorFeed::close() {
+#ifdef _WIN32
+    if (header) UnmapViewOfFile(header);
+    if (mapping) CloseHandle(mapping);
+    mapping = nullptr;
+#else
+    if (owner && !segment.empty()) {
+        // unlink only our own segment, not one another table has since created
+        const string path = "/" + segment;
+        const int current = shm_open(path.c_str(), O_RDONLY, 0);
+        struct stat mine, named;
+        if (current >= 0 && fstat(fd, &mine) == 0 && fstat(current, &named) == 0
+            && mine.st_dev == named.st_dev && mine.st_ino == named.st_ino)
+            shm_unlink(path.c_str());
+        if (current >= 0) ::close(current);
+    }
+    if (header) munmap(header, bytes);
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+#endif
+    header = nullptr;
+    slots = nullptr;
+    bytes = 0;
+    mask = 0;
+    owner = false;
+    segment.clear();
+}
+
+/**
+ * publish(frame)
+ * --------------
+ * Seqlock write of frame n = head: odd sequence, copy, even sequence,
+ * then head. Never blocks and never looks at readers.
+ */
+void SpectatorFeed::publish(const SpectatorFrame& frame) {
+    if (!header || !owner) return;
+    const uint64_t n = header->head.load(memory_order_relaxed);
+    Slot& s = slots[n & mask];
+    s.seq.store(2 * n + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    memcpy(&s.frame, &frame, sizeof(SpectatorFrame));
+    s.seq.store(2 * n + 2, memory_order_release);
+    header->head.store(n + 1, memory_order_release);
+}
+
+bool SpectatorFeed::read(uint64_t n, SpectatorFrame& out) const {
+    return visit(n, [&](const SpectatorFrame& f) { memcpy(&out, &f, sizeof(SpectatorFrame)); });
+}
+
+namespace {
+
+const char* eventName(uint8_t e) {
+    switch (e) {
+    case SpectatorFrame::Deal: return "DEAL";
+    case SpectatorFrame::Action: return "ACTION";
+    case SpectatorFrame::Dealer: return "DEALER";
+    case SpectatorFrame::Settle: return "SETTLE";
+    default: return "?";
+    }
+}
+
+void printFrame(const SpectatorFrame& f) {
+    cout << "table " << f.tableId << " round " << f.round << " " << eventName(f.event) << "  dealer [";
+    for (int i = 0; i < f.dealerCardCount; ++i) cout << (i ? "," : "") << static_cast<int>(f.dealerCards[i]);
+    cout << "]=" << static_cast<int>(f.dealerValue);
+    for (int s = 0; s < f.seatCount; ++s) {
+        const SpectatorSeat& seat = f.seats[s];
+        if (seat.handCount == 0) continue;
+        cout << " | seat " << (s + 1) << " $" << seat.money;
+        for (int h = 0; h < seat.handCount; ++h) {
+            const SpectatorHand& hand = seat.hands[h];
+            cout << " [";
+            for (int c = 0; c < hand.cardCount; ++c) cout << (c ? "," : "") << static_cast<int>(hand.cards[c]);
+            cout << "]=" << static_cast<int>(hand.value) << " bet " << hand.bet;
+            if (f.event == SpectatorFrame::Settle)
+                cout << (hand.result > 0 ? " WIN" : (hand.result < 0 ? " LOSS" : " PUSH"));
+        }
+    }
+    cout << "\n";
+}
+
+} // namespace
+
+/**
+ * runSpectator(name, frames)
+ * --------------------------
+ * Waits up to 10 s for the feed, then polls it (1 ms naps when idle),
+ * printing the latest frame and each one after it; frames <= 0 runs until
+ * the producer goes away.
+ * Frames overwritten before they could be read are counted as missed.
+ */
+int runSpectator(const string& name, long long frames) {
+    SpectatorFeed feed;
+    for (int tries = 0; !feed.attach(name); ++tries) {
+        if (tries == 1000) {
+            cout << "no spectator feed named " << name << "\n";
+            return 1;
+        }
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    uint64_t next = feed.head();
+    if (next > 0) --next;           // start with the table as it is now
+    long long shown = 0, missed = 0;
+    int idle = 0;
+    SpectatorFrame f;
+    while (frames <= 0 || shown < frames) {
+        const uint64_t head = feed.head();
+        if (next == head) {
+            this_thread::sleep_for(chrono::milliseconds(1));
+            if (++idle % 1000 == 0) {   // every ~second: is the producer still there?
+                SpectatorFeed probe;
+                if (!probe.attach(name)) break;
+            }
+            continue;
+        }
+        idle = 0;
+        if (head - next > feed.capacity()) {
+            missed += static_cast<long long>(head - next - feed.capacity());
+            next = head - feed.capacity();
+        }
+        for (; next < head && (frames <= 0 || shown < frames); ++next) {
+            if (!feed.read(next, f)) { ++missed; continue; }
+            printFrame(f);
+            ++shown;
+        }
+        cout.flush();
+    }
+    cout << "frames shown: " << shown << "  missed: " << missed << "\n";
+    return 0;
+}
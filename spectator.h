@@ -0,0 +1,148 @@
+#ifndef SPECTATOR_H
+#define SPECTATOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * SpectatorFrame
+ * - Fixed-size snapshot of one table after an event: dealer cards, and per
+ *   seat the bankroll plus every hand's bet, cards and (after settling)
+ *   result. Plain bytes, so it can live in shared memory as-is.
+ * - Until the Dealer event only the up card is shown (dealerCardCount 1).
+ * - Cards are blackjack values (2..11); a hand shows its first kMaxCards.
+ */
+struct SpectatorHand {
+    static constexpr int kMaxCards = 8;
+    int32_t bet;
+    uint8_t value;
+    uint8_t cardCount;
+    int8_t result;                  // Settle frames: +1 win / -1 loss / 0 push
+    uint8_t reserved;
+    uint8_t cards[kMaxCards];
+};
+
+struct SpectatorSeat {
+    static constexpr int kMaxHands = 4;
+    int32_t money;
+    uint8_t handCount;
+    uint8_t reserved[3];
+    SpectatorHand hands[kMaxHands];
+};
+
+struct SpectatorFrame {
+    static constexpr int kMaxSeats = 7;
+    static constexpr int kMaxDealerCards = 12;
+    enum Event : uint8_t { Deal = 1, Action, Dealer, Settle };
+
+    uint32_t tableId;
+    uint32_t round;
+    uint8_t event;
+    uint8_t seatCount;
+    uint8_t dealerValue;            // of the shown cards
+    uint8_t dealerCardCount;
+    uint8_t dealerCards[kMaxDealerCards];
+    SpectatorSeat seats[kMaxSeats];
+};
+
+/**
+ * SpectatorFeed
+ * - Single-producer / multi-consumer ring of SpectatorFrames in a named
+ *   shared-memory segment (POSIX shm_open + mmap; a named file mapping on
+ *   Windows). One feed per table; the Table is the only writer.
+ * - Each slot is a seqlock: the writer marks the slot odd, copies the
+ *   frame, then stores the even sequence for frame n (2n + 2). It never
+ *   waits for readers; a slow reader is lapped and finds out from the
+ *   sequence.
+ * - Readers map the segment read-only and poll head(). visit() runs a
+ *   callback on the frame in place (zero copies) and returns false if the
+ *   slot was rewritten meanwhile, in which case whatever the callback saw
+ *   must be thrown away. read() is visit() into a copy.
+ *
+ * - A name belongs to one live table: create() fails while another
+ *   process's feed holds it, and only takes over a segment left behind by
+ *   a producer that is gone (its owner pid no longer runs). close()
+ *   removes the name only if it still refers to this feed's segment.
+ *
+ * Layout: a 64-byte header (magic, version, slot count, frame size, head,
+ * owner pid) followed by `slots` cache-line-aligned Slots.
+ */
+class SpectatorFeed {
+public:
+    static constexpr uint32_t kMagic = 0x46535043;   // "CPSF"
+    static constexpr uint32_t kVersion = 2;
+
+    SpectatorFeed() = default;
+    ~SpectatorFeed() { close(); }
+    SpectatorFeed(const SpectatorFeed&) = delete;
+    SpectatorFeed& operator=(const SpectatorFeed&) = delete;
+
+    // Producer: creates the segment (false if a live table already has the
+    // name); slots is rounded up to a power of two. The segment is removed
+    // again on close().
+    bool create(const std::string& name, uint32_t slots = 1024);
+    // Observer: maps an existing segment read-only.
+    bool attach(const std::string& name);
+    void close();
+    bool isOpen() const { return header != nullptr; }
+
+    void publish(const SpectatorFrame& frame);   // producer only
+
+    uint64_t head() const { return header->head.load(std::memory_order_acquire); }   // frames published
+    uint32_t capacity() const { return header->slotCount; }
+
+    template <class F>
+    bool visit(uint64_t n, F&& f) const;
+    bool read(uint64_t n, SpectatorFrame& out) const;
+
+private:
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t slotCount;
+        uint32_t frameSize;
+        alignas(8) std::atomic<uint64_t> head;
+        uint32_t ownerPid;          // producer process (stale-segment check)
+        uint8_t pad[64 - 28];
+    };
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> seq;
+        SpectatorFrame frame;
+    };
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "feed needs lock-free 64-bit atomics");
+    static_assert(sizeof(Header) == 64, "header is one cache line");
+
+    Header* header = nullptr;
+    Slot* slots = nullptr;
+    uint32_t mask = 0;
+    size_t bytes = 0;
+    bool owner = false;
+    std::string segment;
+#ifdef _WIN32
+    void* mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+
+    bool map(const std::string& name, bool create, uint32_t slotCount);
+#ifndef _WIN32
+    static bool isStale(const std::string& path);
+#endif
+};
+
+template <class F>
+bool SpectatorFeed::visit(uint64_t n, F&& f) const {
+    const Slot& s = slots[n & mask];
+    const uint64_t want = 2 * n + 2;
+    if (s.seq.load(std::memory_order_acquire) != want) return false;   // not yet written, or lapped
+    f(s.frame);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return s.seq.load(std::memory_order_relaxed) == want;
+}
+
+// Driver mode "spectate [segment] [frames]": prints frames as they arrive.
+int runSpectator(const std::string& name, long long frames);
+
+#endif // SPECTATOR_H
@@ -0,0 +1,160 @@
+/*
+ * Engine Stats Implementation
+ * ---------------------------
+ * Owns the fixed pool of per-thread counter slots and turns them into
+ * text/JSON snapshots on demand.
+ *
+ * Each thread allocates its own slot the first time it counts, so the
+ * slot's page is first touched on that thread's NUMA node and its counter
+ * writes never cross a socket; the pointer table only records where the
+ * slots are for snapshots. A thread that exits hands its slot back to a
+ * free list (SlotLease) and the next new thread takes it over, counts and
+ * all, so totals never lose a finished thread and batch after batch of
+ * short-lived workers keeps reusing the same few slots. A reused slot
+ * stays on the node of the thread that allocated it. Claiming and
+ * releasing take a mutex, once per thread; the counting path has no lock
+ * or allocation. Threads beyond the pool size share one static overflow
+ * slot (which then uses atomic adds).
+ */
+
+#include "stats.h"
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace stats {
+
+static const char* const kCounterNames[CounterCount] = {
+    "cards_dealt", "reshuffles", "reshuffle_stalls", "dealer_hits", "dealer_busts",
+    "player_wins", "player_losses", "player_pushes"
+};
+
+static const char* const kPhaseNames[PhaseCount] = {
+    "deal", "dealer", "settle"
+};
+
+const char* counterName(Counter c) { return kCounterNames[c]; }
+const char* phaseName(Phase p) { return kPhaseNames[p]; }
+
+#if CLUB_STATS
+
+static const int kMaxSlots = 256;
+static std::atomic<Slot*> slots[kMaxSlots];    // null until the owner publishes it
+static Slot overflow;
+static std::atomic<int> slotsClaimed{ 0 };
+static std::mutex freeMutex;
+static std::vector<int> freeSlots;             // released by threads that exited
+
+/**
+ * claimSlot()
+ * -----------
+ * Hands the calling thread a slot of its own: one a finished thread gave
+ * back if there is one, else a new one. Called once per thread through
+ * localSlot()'s thread_local SlotLease.
+ */
+Slot& claimSlot() {
+    std::lock_guard<std::mutex> g(freeMutex);
+    if (!freeSlots.empty()) {
+        Slot* reused = slots[freeSlots.back()].load(std::memory_order_relaxed);
+        freeSlots.pop_back();
+        return *reused;
+    }
+    const int idx = slotsClaimed.load(std::memory_order_relaxed);
+    if (idx >= kMaxSlots - 1) {
+        overflow.shared = true;
+        overflow.index = -1;
+        if (idx == kMaxSlots - 1) {
+            slots[idx].store(&overflow, std::memory_order_release);
+            slotsClaimed.store(kMaxSlots, std::memory_order_relaxed);
+        }
+        return overflow;
+    }
+    Slot* mine = new Slot();                // first touch on this thread's node
+    mine->index = idx;
+    slots[idx].store(mine, std::memory_order_release);
+    slotsClaimed.store(idx + 1, std::memory_order_relaxed);
+    return *mine;
+}
+
+/**
+ * releaseSlot(slot)
+ * -----------------
+ * The owning thread is exiting. Its counts stay in the slot (and in every
+ * later snapshot); the slot itself goes to the next thread that claims one.
+ */
+void releaseSlot(Slot& slot) {
+    if (slot.shared) return;                // the overflow slot has no owner
+    std::lock_guard<std::mutex> g(freeMutex);
+    freeSlots.push_back(slot.index);
+}
+
+int slotCount() { return slotsClaimed.load(std::memory_order_relaxed); }
+
+/**
+ * snapshotStats()
+ * ---------------
+ * Sums every claimed slot. Readers never block writers; a snapshot taken
+ * while tables are running is simply a point somewhere in the middle.
+ */
+Snapshot snapshotStats() {
+    Snapshot out;
+    const int used = slotsClaimed.load(std::memory_order_relaxed);
+    for (int i = 0; i < used; ++i) {
+        const Slot* p = slots[i].load(std::memory_order_acquire);
+        if (!p) continue;                   // claimed, not yet published
+        const Slot& s = *p;
+        for (int c = 0; c < CounterCount; ++c)
+            out.counters[c] += s.counters[c].load(std::memory_order_relaxed);
+        for (int p = 0; p < PhaseCount; ++p) {
+            out.phaseNanos[p] += s.phaseNanos[p].load(std::memory_order_relaxed);
+            out.phaseCalls[p] += s.phaseCalls[p].load(std::memory_order_relaxed);
+        }
+    }
+    return out;
+}
+
+#else
+
+Snapshot snapshotStats() { return Snapshot(); }
+int slotCount() { return 0; }
+
+#endif // CLUB_STATS
+
+/**
+ * toText()
+ * --------
+ * One "name value" line per counter, then one line per phase with call
+ * count, total and mean time.
+ */
+std::string Snapshot::toText() const {
+    std::ostringstream os;
+    for (int c = 0; c < CounterCount; ++c)
+        os << kCounterNames[c] << " " << counters[c] << "\n";
+    for (int p = 0; p < PhaseCount; ++p) {
+        const uint64_t mean = phaseCalls[p] ? phaseNanos[p] / phaseCalls[p] : 0;
+        os << "phase." << kPhaseNames[p] << " calls=" << phaseCalls[p]
+            << " total_ns=" << phaseNanos[p] << " mean_ns=" << mean << "\n";
+    }
+    return os.str();
+}
+
+/**
+ * toJson()
+ * --------
+ * {"counters":{...},"phases":{"deal":{"calls":n,"total_ns":n},...}}
+ */
+std::string Snapshot::toJson() const {
+    std::ostringstream os;
+    os << "{\"counters\":{";
+    for (int c = 0; c < CounterCount; ++c)
+        os << (c ? "," : "") << "\"" << kCounterNames[c] << "\":" << counters[c];
+    os << "},\"phases\":{";
+    for (int p = 0; p < PhaseCount; ++p) {
+        os << (p ? "," : "") << "\"" << kPhaseNames[p] << "\":{\"calls\":" << phaseCalls[p]
+            << ",\"total_ns\":" << phaseNanos[p] << "}";
+    }
+    os << "}}";
+    return os.str();
+}
+
+} // namespace stats
@@ -0,0 +1,146 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * Engine Stats
+ * - Hot-path counters for the round engine (cards dealt, reshuffles,
+ *   dealer hits/busts, settlement outcomes) plus time spent per phase.
+ * - Every thread gets its own cache-line sized slot, allocated by that
+ *   thread (so on its NUMA node), and bumping a counter is a plain
+ *   load/store on memory no other thread writes. A thread's slot is
+ *   handed to the next new thread when it exits.
+ * - snapshotStats() sums all slots on demand without taking any lock.
+ *
+ * Build flag:
+ *  - CLUB_STATS=1 (default) compiles the counters in.
+ *  - CLUB_STATS=0 turns every CLUB_STAT_* macro into a no-op, so the
+ *    engine carries no trace of them.
+ */
+#ifndef CLUB_STATS
+#define CLUB_STATS 1
+#endif
+
+namespace stats {
+
+enum Counter {
+    CardsDealt = 0,
+    Reshuffles,
+    ReshuffleStalls,   // reshuffles done in place because no pre-shuffled shoe was ready
+    DealerHits,
+    DealerBusts,
+    PlayerWins,
+    PlayerLosses,
+    PlayerPushes,
+    CounterCount
+};
+
+enum Phase {
+    PhaseDeal = 0,     // Table::startRound
+    PhaseDealer,       // Table::dealerPlay
+    PhaseSettle,       // Table::settleBets
+    PhaseCount
+};
+
+const char* counterName(Counter c);
+const char* phaseName(Phase p);
+
+// Aggregated view of every thread's slot at the time of the call.
+struct Snapshot {
+    uint64_t counters[CounterCount] = {};
+    uint64_t phaseNanos[PhaseCount] = {};
+    uint64_t phaseCalls[PhaseCount] = {};
+
+    std::string toText() const;
+    std::string toJson() const;
+};
+
+Snapshot snapshotStats();
+int slotCount();    // slots allocated so far; exited threads hand theirs on
+
+// Monotonic clock in nanoseconds (shared by the phase timers).
+inline uint64_t nowNanos() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+#if CLUB_STATS
+
+// One slot per thread, padded to its own cache line(s).
+struct alignas(64) Slot {
+    std::atomic<uint64_t> counters[CounterCount];
+    std::atomic<uint64_t> phaseNanos[PhaseCount];
+    std::atomic<uint64_t> phaseCalls[PhaseCount];
+    bool shared;   // true only for the overflow slot (too many threads)
+    int index;     // position in the slot table; -1 for the overflow slot
+};
+
+Slot& claimSlot();
+void releaseSlot(Slot& slot);
+
+// Holds the thread's slot and hands it back when the thread exits, so
+// short-lived workers (a fresh batch per runPinned call) reuse slots
+// instead of running out of them.
+struct SlotLease {
+    Slot& slot;
+    SlotLease() : slot(claimSlot()) {}
+    ~SlotLease() { releaseSlot(slot); }
+    SlotLease(const SlotLease&) = delete;
+    SlotLease& operator=(const SlotLease&) = delete;
+};
+
+inline Slot& localSlot() {
+    static thread_local SlotLease lease;
+    return lease.slot;
+}
+
+// Single writer per slot: a relaxed load+store is enough (no lock prefix).
+// The overflow slot is shared by late threads, so it falls back to fetch_add.
+inline void bump(Slot& s, std::atomic<uint64_t>& cell, uint64_t n) {
+    if (s.shared) cell.fetch_add(n, std::memory_order_relaxed);
+    else cell.store(cell.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+inline void add(Counter c, uint64_t n) {
+    Slot& s = localSlot();
+    bump(s, s.counters[c], n);
+}
+
+// RAII timer: adds the elapsed time of its scope to a phase.
+class PhaseTimer {
+public:
+    explicit PhaseTimer(Phase p) : phase(p), start(nowNanos()) {}
+    ~PhaseTimer() {
+        Slot& s = localSlot();
+        bump(s, s.phaseNanos[phase], nowNanos() - start);
+        bump(s, s.phaseCalls[phase], 1);
+    }
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+private:
+    Phase phase;
+    uint64_t start;
+};
+
+#define CLUB_STAT_ADD(counter, n) ::stats::add(::stats::counter, (n))
+#define CLUB_STAT_INC(counter)    ::stats::add(::stats::counter, 1)
+#define CLUB_STAT_CAT2(a, b) a##b
+#define CLUB_STAT_CAT(a, b) CLUB_STAT_CAT2(a, b)
+#define CLUB_PHASE_TIMER(phase) \
+    ::stats::PhaseTimer CLUB_STAT_CAT(clubPhaseTimer_, __LINE__)(::stats::phase)
+
+#else
+
+#define CLUB_STAT_ADD(counter, n) ((void)0)
+#define CLUB_STAT_INC(counter)    ((void)0)
+#define CLUB_PHASE_TIMER(phase)   ((void)0)
+
+#endif // CLUB_STATS
+
+} // namespace stats
+
+#endif // STATS_H
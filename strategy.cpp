@@ -0,0 +1,198 @@
+/*
+ * Bot Strategy Implementation
+ * ---------------------------
+ * Hit/stand, double and split charts for the automated player policies.
+ *
+ * Charts are the usual multi-deck, dealer-stands-on-soft-17 basic strategy
+ * with doubling after splits. The Table has no surrender and no dealer
+ * peek, so those columns don't apply.
+ */
+
+#include "strategy.h"
+#include <cmath>
+
+/**
+ * basicHit(total, soft, up)
+ * -------------------------
+ * Hard totals:
+ *  - 11 or less: hit
+ *  - 12: stand vs 4-6, else hit
+ *  - 13-16: stand vs 2-6, else hit
+ *  - 17+: stand
+ * Soft totals:
+ *  - 17 or less: hit
+ *  - 18: hit vs 9, 10, A; else stand
+ *  - 19+: stand
+ */
+static bool basicHit(int total, bool soft, int up) {
+    if (soft) {
+        if (total <= 17) return true;
+        if (total == 18) return up >= 9;
+        return false;
+    }
+    if (total <= 11) return true;
+    if (total == 12) return up < 4 || up > 6;
+    if (total <= 16) return up > 6;
+    return false;
+}
+
+/**
+ * basicDouble(total, soft, up)
+ * ----------------------------
+ * Hard: 9 vs 3-6, 10 vs 2-9, 11 vs 2-10.
+ * Soft: 13-14 vs 5-6, 15-16 vs 4-6, 17-18 vs 3-6.
+ */
+static bool basicDouble(int total, bool soft, int up) {
+    if (soft) {
+        if (total == 13 || total == 14) return up >= 5 && up <= 6;
+        if (total == 15 || total == 16) return up >= 4 && up <= 6;
+        if (total == 17 || total == 18) return up >= 3 && up <= 6;
+        return false;
+    }
+    if (total == 9) return up >= 3 && up <= 6;
+    if (total == 10) return up <= 9;
+    if (total == 11) return up <= 10;
+    return false;
+}
+
+/**
+ * basicSplit(pairCard, up)
+ * ------------------------
+ *  - A, 8: always          - 10, 5: never
+ *  - 2, 3, 7: vs 2-7       - 4: vs 5-6
+ *  - 6: vs 2-6             - 9: vs 2-6, 8-9
+ */
+static bool basicSplit(int pairCard, int up) {
+    switch (pairCard) {
+    case 11: case 8: return true;
+    case 2: case 3: case 7: return up <= 7;
+    case 4: return up == 5 || up == 6;
+    case 6: return up <= 6;
+    case 9: return up <= 9 && up != 7;
+    default: return false;
+    }
+}
+
+bool BasicStrategy::shouldHit(const HandContext& c) const {
+    return basicHit(c.total, c.soft, c.dealerUp);
+}
+
+bool BasicStrategy::shouldDouble(const HandContext& c) const {
+    return basicDouble(c.total, c.soft, c.dealerUp);
+}
+
+bool BasicStrategy::shouldSplit(const HandContext& c) const {
+    return basicSplit(c.pairCard, c.dealerUp);
+}
+
+/**
+ * observe(card, cardShoeId)
+ * -------------------------
+ * Hi-Lo tag of one card. A new shoe id means the deck was reshuffled,
+ * so the count starts over.
+ */
+void HiLoCounting::observe(int card, int cardShoeId) {
+    if (cardShoeId != shoeId) {
+        shoeId = cardShoeId;
+        runningCount = 0;
+    }
+    if (card >= 2 && card <= 6) ++runningCount;
+    else if (card >= 10) --runningCount;
+}
+
+/**
+ * trueCount(cardsLeft)
+ * --------------------
+ * Running count per remaining deck (floored at half a deck so the
+ * last few cards don't blow the value up).
+ */
+double HiLoCounting::trueCount(size_t cardsLeft) const {
+    double decks = static_cast<double>(cardsLeft) / 52.0;
+    if (decks < 0.5) decks = 0.5;
+    return runningCount / decks;
+}
+
+/**
+ * shouldHit(c)
+ * ------------
+ * Basic strategy, overridden by the hard-total hit/stand indices:
+ *  - 16 vs 10: stand at TC >= 0      - 16 vs 9: stand at TC >= 5
+ *  - 15 vs 10: stand at TC >= 4      - 13 vs 2: hit at TC <= -1
+ *  - 13 vs 3: hit at TC <= -2        - 12 vs 2: stand at TC >= 3
+ *  - 12 vs 3: stand at TC >= 2       - 12 vs 4: hit at TC < 0
+ *  - 12 vs 5: hit at TC <= -2        - 12 vs 6: hit at TC <= -1
+ */
+double HiLoCounting::flooredCount(const HandContext& c) const {
+    // No card of this shoe seen yet: the count is still zero.
+    return (c.shoeId == shoeId) ? std::floor(trueCount(c.cardsLeft)) : 0.0;
+}
+
+bool HiLoCounting::shouldHit(const HandContext& c) const {
+    if (c.soft) return basicHit(c.total, true, c.dealerUp);
+
+    const double tc = flooredCount(c);
+    const int t = c.total;
+    const int up = c.dealerUp;
+
+    if (t == 16 && up == 10) return tc < 0;
+    if (t == 16 && up == 9)  return tc < 5;
+    if (t == 15 && up == 10) return tc < 4;
+    if (t == 13 && up == 2)  return tc <= -1;
+    if (t == 13 && up == 3)  return tc <= -2;
+    if (t == 12 && up == 2)  return tc < 3;
+    if (t == 12 && up == 3)  return tc < 2;
+    if (t == 12 && up == 4)  return tc < 0;
+    if (t == 12 && up == 5)  return tc <= -2;
+    if (t == 12 && up == 6)  return tc <= -1;
+    return basicHit(t, false, up);
+}
+
+/**
+ * shouldDouble(c)
+ * ---------------
+ * Basic strategy, plus the hard double indices:
+ *  - 11 vs A: double at TC >= 1      - 10 vs 10: double at TC >= 4
+ *  - 10 vs A: double at TC >= 4      - 9 vs 2: double at TC >= 1
+ *  - 9 vs 7: double at TC >= 3
+ */
+bool HiLoCounting::shouldDouble(const HandContext& c) const {
+    if (c.soft) return basicDouble(c.total, true, c.dealerUp);
+
+    const double tc = flooredCount(c);
+    const int t = c.total;
+    const int up = c.dealerUp;
+
+    if (t == 11 && up == 11) return tc >= 1;
+    if (t == 10 && up == 10) return tc >= 4;
+    if (t == 10 && up == 11) return tc >= 4;
+    if (t == 9 && up == 2)   return tc >= 1;
+    if (t == 9 && up == 7)   return tc >= 3;
+    return basicDouble(t, false, up);
+}
+
+/**
+ * shouldSplit(c)
+ * --------------
+ * Basic strategy, plus splitting tens:
+ *  - 10,10 vs 5: split at TC >= 5    - 10,10 vs 6: split at TC >= 4
+ */
+bool HiLoCounting::shouldSplit(const HandContext& c) const {
+    if (c.pairCard == 10 && (c.dealerUp == 5 || c.dealerUp == 6))
+        return flooredCount(c) >= (c.dealerUp == 5 ? 5 : 4);
+    return basicSplit(c.pairCard, c.dealerUp);
+}
+
+/**
+ * strategyName(s)
+ * ---------------
+ * Short label for reports and prompts.
+ */
+const char* strategyName(const BotStrategy& s) {
+    switch (s.index()) {
+    case 0: return "basic";
+    case 1: return "hit-below";
+    case 2: return "mimic-dealer";
+    case 3: return "hi-lo";
+    default: return "?";
+    }
+}
@@ -0,0 +1,323 @@
+#ifndef STRATEGY_H
+#define STRATEGY_H
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <variant>
+#include "player.h"
+#include "table.h"
+#include "player_store.h"
+
+/**
+ * Bot strategies
+ * - Policies for automated players. Each policy is a plain struct with
+ *   shouldHit / shouldDouble / shouldSplit(const HandContext&) and
+ *   observe(card, shoeId); nothing is virtual, so a simulation templated on
+ *   the policy pays a direct call.
+ * - BotStrategy is a std::variant of every policy, for places (like the
+ *   interactive table) that pick a policy at run time; dispatch is a
+ *   std::visit jump table, still no vtable or std::function.
+ *
+ * Policies:
+ *  - BasicStrategy: standard hit/stand, double and split charts
+ *  - HitBelow: hit while total < threshold (never doubles or splits)
+ *  - MimicDealer: play the dealer's rule (hit 16, optional soft 17)
+ *  - HiLoCounting: basic strategy + Hi-Lo true-count index plays
+ */
+
+// Everything a policy may look at when deciding.
+struct HandContext {
+    int total = 0;          // Person::handValue()
+    bool soft = false;      // Person::isSoft()
+    int dealerUp = -1;      // dealer's up card value (2..11)
+    size_t cardsLeft = 0;   // cards remaining in the shoe
+    int shoeId = 0;         // Deck::shuffleCount(), changes on reshuffle
+    bool canDouble = false; // Player::canDouble() for this hand
+    bool canSplit = false;  // Player::canSplit() for this hand
+    int pairCard = 0;       // card value of a two-card pair, else 0
+};
+
+struct BasicStrategy {
+    bool shouldHit(const HandContext& c) const;
+    bool shouldDouble(const HandContext& c) const;
+    bool shouldSplit(const HandContext& c) const;
+    void observe(int, int) {}
+};
+
+struct HitBelow {
+    int threshold = 17;
+    bool shouldHit(const HandContext& c) const { return c.total < threshold; }
+    bool shouldDouble(const HandContext&) const { return false; }
+    bool shouldSplit(const HandContext&) const { return false; }
+    void observe(int, int) {}
+};
+
+struct MimicDealer {
+    bool hitSoft17 = false;
+    bool shouldHit(const HandContext& c) const {
+        return c.total <= 16 || (c.total == 17 && c.soft && hitSoft17);
+    }
+    bool shouldDouble(const HandContext&) const { return false; }
+    bool shouldSplit(const HandContext&) const { return false; }
+    void observe(int, int) {}
+};
+
+/**
+ * HiLoCounting
+ * - Keeps a Hi-Lo running count of every card it is shown (2-6 = +1,
+ *   7-9 = 0, 10/A = -1) and resets when the shoe id changes.
+ * - Deviates from basic strategy on the stand/hit, double and
+ *   ten-splitting index plays.
+ */
+struct HiLoCounting {
+    int runningCount = 0;
+    int shoeId = -1;
+
+    void observe(int card, int cardShoeId);
+    double trueCount(size_t cardsLeft) const;
+    bool shouldHit(const HandContext& c) const;
+    bool shouldDouble(const HandContext& c) const;
+    bool shouldSplit(const HandContext& c) const;
+
+private:
+    double flooredCount(const HandContext& c) const;
+};
+
+using BotStrategy = std::variant<BasicStrategy, HitBelow, MimicDealer, HiLoCounting>;
+
+const char* strategyName(const BotStrategy& s);
+
+// Builds the decision context for one of a seated player's hands.
+inline HandContext makeContext(const Player& p, int hand, const Table& table) {
+    const Hand& h = p.handAt(hand);
+    HandContext c;
+    c.total = h.value();
+    c.soft = h.isSoft();
+    c.dealerUp = table.dealerUpCard();
+    c.cardsLeft = table.getDeck().cardsRemaining();
+    c.shoeId = table.getDeck().shuffleCount();
+    c.canDouble = p.canDouble(hand);
+    c.canSplit = p.canSplit(hand);
+    c.pairCard = h.isPair() ? h.front() : 0;
+    return c;
+}
+
+inline HandContext makeContext(const Player& p, const Table& table) {
+    return makeContext(p, 0, table);
+}
+
+// Same, for a seat in a PlayerStore.
+inline HandContext makeContext(const PlayerStore& seats, size_t seat, const Table& table) {
+    HandContext c;
+    c.total = seats.handValue(seat);
+    c.soft = seats.isSoft(seat);
+    c.dealerUp = table.dealerUpCard();
+    c.cardsLeft = table.getDeck().cardsRemaining();
+    c.shoeId = table.getDeck().shuffleCount();
+    return c;
+}
+
+// Static dispatch: a concrete policy is called directly...
+template <class Policy>
+inline bool decideHit(Policy& policy, const HandContext& c) {
+    return policy.shouldHit(c);
+}
+
+// ...and the variant goes through std::visit.
+inline bool decideHit(BotStrategy& s, const HandContext& c) {
+    return std::visit([&](auto& policy) { return policy.shouldHit(c); }, s);
+}
+
+// Double/split only ask the policy when the hand is allowed to.
+template <class Policy>
+inline bool decideDouble(Policy& policy, const HandContext& c) {
+    return c.canDouble && policy.shouldDouble(c);
+}
+
+inline bool decideDouble(BotStrategy& s, const HandContext& c) {
+    return c.canDouble && std::visit([&](auto& policy) { return policy.shouldDouble(c); }, s);
+}
+
+template <class Policy>
+inline bool decideSplit(Policy& policy, const HandContext& c) {
+    return c.canSplit && policy.shouldSplit(c);
+}
+
+inline bool decideSplit(BotStrategy& s, const HandContext& c) {
+    return c.canSplit && std::visit([&](auto& policy) { return policy.shouldSplit(c); }, s);
+}
+
+template <class Policy>
+inline void observeCard(Policy& policy, int card, int shoeId) {
+    policy.observe(card, shoeId);
+}
+
+inline void observeCard(BotStrategy& s, int card, int shoeId) {
+    std::visit([&](auto& policy) { policy.observe(card, shoeId); }, s);
+}
+
+// Shows a policy every card on the table (call before settleBets clears hands).
+template <class Policy>
+inline void observeTable(Policy& policy, const Table& table) {
+    const int shoeId = table.getDeck().shuffleCount();
+    for (const Player* p : table.getPlayers())
+        for (int h = 0; h < p->handCount(); ++h)
+            for (int card : p->handAt(h)) observeCard(policy, card, shoeId);
+    for (int card : table.getDealer().getHand()) observeCard(policy, card, shoeId);
+}
+
+/**
+ * playBotTurn(policy, player, table)
+ * - Silent automated turn through the Table, one hand at a time (hands
+ *   made by a split are played after the ones before them): split while
+ *   the policy says so, then double, or hit until the policy stands or
+ *   the hand reaches 21+ (also when a double is refused). Returns the number of cards taken (hits and
+ *   double cards).
+ */
+template <class Policy>
+inline int playBotTurn(Policy& policy, Player& p, Table& table) {
+    int hits = 0;
+    for (int h = 0; h < p.handCount(); ++h) {
+        while (decideSplit(policy, makeContext(p, h, table))) table.playerSplit(p, h);
+        if (p.isHandLocked(h)) continue;   // split aces
+        if (decideDouble(policy, makeContext(p, h, table)) && table.playerDouble(p, h)) {
+            ++hits;
+            continue;
+        }
+        while (p.handAt(h).value() < 21 && decideHit(policy, makeContext(p, h, table))) {
+            table.playerHit(p, h);
+            ++hits;
+        }
+        if (p.handAt(h).value() <= 21) table.playerStand(p);
+    }
+    return hits;
+}
+
+// PlayerStore version of playBotTurn (no journal, so no stand record).
+template <class Policy>
+inline int playBotTurn(Policy& policy, PlayerStore& seats, size_t seat, Table& table) {
+    int hits = 0;
+    while (seats.handValue(seat) < 21 && decideHit(policy, makeContext(seats, seat, table))) {
+        table.playerHit(seats, seat);
+        ++hits;
+    }
+    return hits;
+}
+
+/**
+ * Table::playRounds(n, policy, out)
+ * - Runs n complete rounds for every seated player with the same policy:
+ *   1. one pass dealing the first cards, one pass dealing the second
+ *      (seats with no money or no bet sit out)
+ *   2. one pass of player turns (split / double / hit, hand by hand, as
+ *      in playBotTurn)
+ *   3. dealer plays only if some hand is still live
+ *   4. one pass that shows the cards to the policy and settles every hand
+ *      of each seat, then clears the seat
+ * - Each seat stakes its current bet, capped for that round by its
+ *   bankroll and the table maximum; the bet itself is left alone, so a
+ *   raised limit applies again from the next round. Wins, losses and
+ *   pushes count hands; net counts each hand's own bet.
+ * - Returns the number of rounds played (stops early once everyone is broke).
+ */
+template <class Policy>
+size_t Table::playRounds(size_t n, Policy& policy, RoundResult* out) {
+    uint64_t won = 0, lost = 0, pushed = 0;
+    size_t played = 0;
+    const size_t seatCount = players.size();
+
+    for (; played < n; ++played) {
+        RoundResult& r = out[played];
+        r = RoundResult();
+
+        // 1. deal (rules only change here, between rounds)
+        if (rules) refreshRules();
+        const int maxBet = rules ? rules->get().maxBet : INT_MAX;
+        const int minBet = rules ? rules->get().minBet : 1;
+        dealer.clearHand();
+        for (int pass = 0; pass < 2; ++pass) {
+            for (size_t i = 0; i < seatCount; ++i) {
+                Player* p = players[i];
+                if (pass == 0) {
+                    if (!p || p->getMoney() <= 0 || p->getBet() <= 0) continue;
+                    const int cap = std::min(p->getMoney(), maxBet);   // this round only
+                    if (std::min(p->getBet(), cap) < minBet) continue;   // can't cover the table minimum
+                    if (!p->coverBet(cap)) continue;      // wallet seat the account can't cover
+                    ++r.seatsPlayed;
+                }
+                else if (!p || p->getHand().empty()) continue;   // sat out pass 0
+                p->cardDealt(deck.deal());
+            }
+            dealer.cardDealt(deck.deal());
+        }
+        if (r.seatsPlayed == 0) break;
+
+        // 2. player turns
+        bool anyLive = false;
+        for (size_t i = 0; i < seatCount; ++i) {
+            if (!players[i] || players[i]->getHand().empty()) continue;
+            Player& p = *players[i];
+            for (int h = 0; h < p.handCount(); ++h) {
+                while (decideSplit(policy, makeContext(p, h, *this))) {
+                    const bool aces = p.handAt(h).front() == 11;
+                    const int other = p.splitHand(h);
+                    if (other < 0) break;
+                    p.dealToHand(h, deck.deal());
+                    p.dealToHand(other, deck.deal());
+                    if (aces) { p.lockHand(h); p.lockHand(other); }
+                }
+                if (!p.isHandLocked(h)) {
+                    if (decideDouble(policy, makeContext(p, h, *this)) && p.doubleHand(h)) {
+                        p.dealToHand(h, deck.deal());
+                    }
+                    else {
+                        while (p.handAt(h).value() < 21 && decideHit(policy, makeContext(p, h, *this)))
+                            p.dealToHand(h, deck.deal());
+                    }
+                }
+                anyLive = anyLive || p.handAt(h).value() <= 21;
+            }
+        }
+
+        // 3. dealer
+        if (anyLive) {
+            dealer.playHand(deck);
+            r.dealerTotal = static_cast<uint8_t>(dealer.handValue());
+        }
+        const int dVal = dealer.handValue();
+        const bool dBust = dVal > 21;
+
+        // 4. observe + settle
+        const int shoeId = deck.shuffleCount();
+        for (int card : dealer.getHand()) observeCard(policy, card, shoeId);
+        for (size_t i = 0; i < seatCount; ++i) {
+            if (!players[i] || players[i]->getHand().empty()) continue;
+            Player& p = *players[i];
+            for (int h = 0; h < p.handCount(); ++h) {
+                const Hand& hand = p.handAt(h);
+                for (int card : hand) observeCard(policy, card, shoeId);
+                const int v = hand.value();
+                const int result = (v > 21 || (!dBust && v < dVal)) ? -1 : ((dBust || v > dVal) ? 1 : 0);
+                p.settleHand(h, result);
+                r.net += result * p.betOn(h);
+                if (result > 0) ++r.wins;
+                else if (result < 0) ++r.losses;
+                else ++r.pushes;
+            }
+            p.clearHand();
+        }
+        won += r.wins;
+        lost += r.losses;
+        pushed += r.pushes;
+    }
+    dealer.clearHand();
+
+    CLUB_STAT_ADD(PlayerWins, won);
+    CLUB_STAT_ADD(PlayerLosses, lost);
+    CLUB_STAT_ADD(PlayerPushes, pushed);
+    (void)won; (void)lost; (void)pushed;
+    return played;
+}
+
+#endif // STRATEGY_H
@@ -15,12 +15,31 @@
 
 #include "table.h"
 #include "dealer.h"
+#include "card.h"
+#include "stats.h"
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
+#include <cstring>
 
 using std::cout;
 using std::endl;
 
+namespace {
+
+// settleBets() output when the table is quiet (one per thread: formatting
+// state lives in the stream)
+std::ostream& quietStream() {
+    struct NullBuffer : std::streambuf {
+        int overflow(int c) override { return c; }
+    };
+    thread_local NullBuffer buffer;
+    thread_local std::ostream stream(&buffer);
+    return stream;
+}
+
+} // namespace
+
 /**
  * Table constructor
  * -----------------
@@ -64,16 +83,64 @@ size_t Table::playerCount() {
  * Deals one card to the dealer by drawing from the Deck.
  */
 void Table::dealOneToDealer() {
-    dealer.cardDealt(deck.deal());
+    const uint8_t code = deck.dealCard();
+    dealer.cardDealt(card::value(code));
+    if (journal) journal->dealerCard(code);
+}
+
+/**
+ * dealOneToPlayer(p, hand)
+ * ------------------------
+ * Deals one card to one of the Player's hands by drawing from the Deck.
+ */
+void Table::dealOneToPlayer(Player& p, int hand) {
+    const uint8_t code = deck.dealCard();
+    p.dealToHand(hand, card::value(code));
+    if (journal) journal->card(p, hand, code);
 }
 
 /**
- * dealOneToPlayer(p)
+ * snapshot(f, event)
  * ------------------
- * Deals one card to the specified Player by drawing from the Deck.
+ * Fills a spectator frame from the current table state. The dealer's hole
+ * card stays hidden until the Dealer event; seats past the frame's seat
+ * count and cards past a hand's card slots are left out.
  */
-void Table::dealOneToPlayer(Player& p) {
-    p.cardDealt(deck.deal());
+void Table::snapshot(SpectatorFrame& f, uint8_t event) const {
+    std::memset(&f, 0, sizeof(f));
+    f.tableId = feedTableId;
+    f.round = roundsStarted;
+    f.event = event;
+
+    const Hand& d = dealer.getHand();
+    const size_t shown = event >= SpectatorFrame::Dealer ? d.size() : std::min<size_t>(d.size(), 1);
+    f.dealerCardCount = static_cast<uint8_t>(std::min<size_t>(shown, SpectatorFrame::kMaxDealerCards));
+    for (size_t i = 0; i < f.dealerCardCount; ++i) f.dealerCards[i] = static_cast<uint8_t>(d[i]);
+    f.dealerValue = static_cast<uint8_t>(shown == d.size() ? d.value() : (shown ? d[0] : 0));
+
+    f.seatCount = static_cast<uint8_t>(std::min<size_t>(players.size(), SpectatorFrame::kMaxSeats));
+    for (size_t s = 0; s < f.seatCount; ++s) {
+        const Player* p = players[s];
+        if (!p) continue;
+        SpectatorSeat& seat = f.seats[s];
+        seat.money = p->getMoney();
+        seat.handCount = static_cast<uint8_t>(std::min(p->handCount(), SpectatorSeat::kMaxHands));
+        for (int h = 0; h < seat.handCount; ++h) {
+            const Hand& cards = p->handAt(h);
+            SpectatorHand& out = seat.hands[h];
+            out.bet = p->betOn(h);
+            out.value = static_cast<uint8_t>(cards.value());
+            out.cardCount = static_cast<uint8_t>(std::min<size_t>(cards.size(), SpectatorHand::kMaxCards));
+            for (size_t c = 0; c < out.cardCount; ++c) out.cards[c] = static_cast<uint8_t>(cards[c]);
+        }
+    }
+}
+
+void Table::publish(uint8_t event) const {
+    if (!feed) return;
+    SpectatorFrame f;
+    snapshot(f, event);
+    feed->publish(f);
 }
 
 /**
@@ -82,10 +149,22 @@ void Table::dealOneToPlayer(Player& p) {
  * Begins a new round of Blackjack by:
  *  1. Clearing all player and dealer hands.
  *  2. Dealing two cards to each player and two to the dealer.
+ * With a journal attached, the shoe position and bets are recorded first.
  */
 void Table::startRound() {
+    CLUB_PHASE_TIMER(PhaseDeal);
+    ScopedLatency timed(latency.startRound);
+
     // Step 1: Clear all hands before dealing
     clearHands();
+    ++roundsStarted;
+
+    if (journal) {
+        journal->beginRound(deck.getSeed(), deck.shuffleCount(), deck.shoePosition());
+        for (auto* p : players) {
+            if (p && p->getMoney() > 0) journal->bet(*p, p->getBet());
+        }
+    }
 
     // Step 2: Initial deal  first card to each player
     for (auto* p : players) {
@@ -102,6 +181,74 @@ void Table::startRound() {
         dealOneToPlayer(*p);
     }
     dealOneToDealer();  // Dealers second card
+    publish(SpectatorFrame::Deal);
+}
+
+/**
+ * playerHit(p, hand)
+ * -------------------
+ * Handles a player's "hit" action: deals one card from the Deck to the
+ * given hand (doubled hands and split aces take no more cards).
+ * Timed as player action handling (the prompt itself is not included).
+ */
+void Table::playerHit(Player& p, int hand) {
+    if (p.isHandLocked(hand)) return;
+    ScopedLatency timed(latency.playerAction);
+    if (journal) journal->action(p, HandJournal::ActionHit);
+    dealOneToPlayer(p, hand);
+    publish(SpectatorFrame::Action);
+}
+
+/**
+ * playerDouble(p, hand)
+ * ----------------------
+ * Doubles the hand's bet and deals exactly one card; the hand is then
+ * locked. Refused (false) unless the hand has two cards and the player
+ * can cover the extra bet.
+ */
+bool Table::playerDouble(Player& p, int hand) {
+    if (!p.canDouble(hand)) return false;
+    ScopedLatency timed(latency.playerAction);
+    if (!p.doubleHand(hand)) return false;     // wallet taken by another table meanwhile
+    if (journal) journal->action(p, HandJournal::ActionDouble);
+    dealOneToPlayer(p, hand);
+    publish(SpectatorFrame::Action);
+    return true;
+}
+
+/**
+ * playerSplit(p, hand)
+ * ---------------------
+ * Splits a pair into two hands with the same bet and deals one card to
+ * each. Split aces are locked with their one card. Returns the new hand's
+ * index, or -1 if the hand can't be split.
+ */
+int Table::playerSplit(Player& p, int hand) {
+    if (!p.canSplit(hand)) return -1;
+    ScopedLatency timed(latency.playerAction);
+    const bool aces = p.handAt(hand).front() == 11;
+    const int other = p.splitHand(hand);
+    if (other < 0) return -1;
+    if (journal) journal->action(p, HandJournal::ActionSplit);
+    dealOneToPlayer(p, hand);
+    dealOneToPlayer(p, other);
+    if (aces) {
+        p.lockHand(hand);
+        p.lockHand(other);
+    }
+    publish(SpectatorFrame::Action);
+    return other;
+}
+
+/**
+ * playerStand(p)
+ * ---------------
+ * Handles a player's "stand" action. Nothing is dealt; the decision is
+ * only recorded in the hand history.
+ */
+void Table::playerStand(Player& p) {
+    if (journal) journal->action(p, HandJournal::ActionStand);
+    publish(SpectatorFrame::Action);
 }
 
 /**
@@ -111,71 +258,169 @@ void Table::startRound() {
  * which continues until the dealer must stand.
  */
 void Table::dealerPlay() {
-    dealer.playHand(deck);
+    CLUB_PHASE_TIMER(PhaseDealer);
+    ScopedLatency timed(latency.dealerPlay);
+    if (journal) {
+        drawn.clear();
+        dealer.playHand(deck, &drawn);
+        for (uint8_t code : drawn) journal->dealerCard(code);
+    }
+    else {
+        dealer.playHand(deck);
+    }
+    publish(SpectatorFrame::Dealer);
 }
 
 /**
  * settleBets()
  * -------------
- * Compares each player's hand against the dealers and adjusts
- * player balances based on outcomes:
+ * Compares each of a player's hands against the dealers and adjusts
+ * player balances based on outcomes (each hand on its own bet):
  *  - Player bust -> lose bet
  *  - Dealer bust -> all remaining players win
  *  - Player > Dealer -> win bet
  *  - Player < Dealer -> lose bet
  *  - Tie -> push (no money changes hands)
  *
- * At the end of the round, the dealers hand is cleared.
+ * At the end of the round, every player hand and the dealers hand are cleared.
+ * With a spectator feed the Settle frame (cards, results, new balances) is
+ * published before the clear.
  */
 void Table::settleBets() {
+    CLUB_PHASE_TIMER(PhaseSettle);
+    ScopedLatency timed(latency.settleBets);
     const int dVal = dealer.handValue();
     const bool dBust = dVal > 21;
+    std::ostream& out = quiet ? quietStream() : cout;
 
-    cout << "\n=== Settlements ===\n";
-    cout << "Dealer: value=" << dVal << (dBust ? " (BUST)\n" : "\n");
+    out << "\n=== Settlements ===\n";
+    out << "Dealer: value=" << dVal << (dBust ? " (BUST)\n" : "\n");
 
-    // Loop through each player and determine outcome
+    SpectatorFrame settled;
+    if (feed) snapshot(settled, SpectatorFrame::Settle);
+    size_t seat = 0;
+
+    // Loop through each player (and each of their hands) and determine outcome
     for (auto* p : players) {
+        const size_t s = seat++;
         if (!p) continue;
 
-        const int bet = p->getBet();
-        const int v = p->handValue();
-        const bool bust = v > 21;
+        for (int h = 0; h < p->handCount(); ++h) {
+            const int bet = p->betOn(h);
+            const int v = p->handAt(h).value();
+            const bool bust = v > 21;
+
+            out << "Player [" << p->getName() << "]";
+            if (p->handCount() > 1) out << " hand " << (h + 1);
+            out << " hand=" << v;
 
-        cout << "Player [" << p->getName() << "] hand=" << v;
+            int result = 0;
+            // Case 1: Player busts immediately loses
+            if (bust) {
+                out << " -> LOSS (-$" << bet << ")\n";
+                result = -1;
+            }
+            // Case 2: Dealer busts, player wins automatically
+            else if (dBust) {
+                out << " -> WIN (+$" << bet << ")\n";
+                result = 1;
+            }
+            // Case 3: Compare player vs dealer values
+            else if (v > dVal) {
+                out << " > dealer(" << dVal << ") -> WIN (+$" << bet << ")\n";
+                result = 1;
+            }
+            else if (v < dVal) {
+                out << " < dealer(" << dVal << ") -> LOSS (-$" << bet << ")\n";
+                result = -1;
+            }
+            else {
+                // Case 4: Tie  push (no win/loss)
+                out << " = dealer(" << dVal << ") -> PUSH ($0)\n";
+            }
 
-        // Case 1: Player busts immediately loses
-        if (bust) {
-            cout << " -> LOSS (-$" << bet << ")\n";
-            p->handLost(bet);
-            continue;
+            p->settleHand(h, result);
+            if (feed && s < SpectatorFrame::kMaxSeats && h < SpectatorSeat::kMaxHands)
+                settled.seats[s].hands[h].result = static_cast<int8_t>(result);
+            if (result > 0) CLUB_STAT_INC(PlayerWins);
+            else if (result < 0) CLUB_STAT_INC(PlayerLosses);
+            else CLUB_STAT_INC(PlayerPushes);
+            if (journal) {
+                const HandJournal::Outcome o = result > 0 ? HandJournal::OutcomeWin
+                    : (result < 0 ? HandJournal::OutcomeLoss : HandJournal::OutcomePush);
+                journal->settle(*p, o, result * bet);
+            }
         }
+        if (feed && s < SpectatorFrame::kMaxSeats) settled.seats[s].money = p->getMoney();
+        p->clearHand();
+    }
+    if (feed) feed->publish(settled);
 
-        // Case 2: Dealer busts, player wins automatically
-        if (dBust) {
-            cout << " -> WIN (+$" << bet << ")\n";
-            p->handWon(bet);
-            continue;
+    // After all players settled, clear the dealer's hand for next round
+    dealer.clearHand();
+    if (journal) journal->endRound();
+}
+
+/**
+ * startRound(seats)
+ * ------------------
+ * PlayerStore version of startRound(): clears every hand with bulk fills,
+ * then deals two passes over the seat arrays (seats with no money sit
+ * out) with the dealer's card after each pass.
+ */
+void Table::startRound(PlayerStore& seats) {
+    CLUB_PHASE_TIMER(PhaseDeal);
+    seats.clearHands();
+    dealer.clearHand();
+
+    const size_t n = seats.size();
+    for (int pass = 0; pass < 2; ++pass) {
+        for (size_t i = 0; i < n; ++i) {
+            if (seats.money[i] <= 0) continue;
+            seats.dealTo(i, deck.deal());
         }
+        dealer.cardDealt(deck.deal());
+    }
+}
 
-        // Case 3: Compare player vs dealer values
-        if (v > dVal) {
-            cout << " > dealer(" << dVal << ") -> WIN (+$" << bet << ")\n";
-            p->handWon(bet);
+/**
+ * settleBets(seats)
+ * ------------------
+ * Same rules as settleBets(), in one linear pass over the seat arrays.
+ * Nothing is printed and the outcome counters are bumped once per call.
+ */
+void Table::settleBets(PlayerStore& seats) {
+    CLUB_PHASE_TIMER(PhaseSettle);
+    const int dVal = dealer.handValue();
+    const bool dBust = dVal > 21;
+    uint64_t won = 0, lost = 0, pushed = 0;
+
+    const size_t n = seats.size();
+    for (size_t i = 0; i < n; ++i) {
+        if (seats.cardCount[i] == 0) continue;   // sat this round out
+        const int v = seats.handValue(i);
+        const int32_t bet = seats.bet[i];
+        if (v > 21 || (!dBust && v < dVal)) {
+            seats.money[i] -= bet;
+            ++seats.losses[i];
+            ++lost;
         }
-        else if (v < dVal) {
-            cout << " < dealer(" << dVal << ") -> LOSS (-$" << bet << ")\n";
-            p->handLost(bet);
+        else if (dBust || v > dVal) {
+            seats.money[i] += bet;
+            ++seats.wins[i];
+            ++won;
         }
         else {
-            // Case 4: Tie  push (no win/loss)
-            cout << " = dealer(" << dVal << ") -> PUSH ($0)\n";
-            // On push, hand is still cleared but no money moves.
-            p->clearHand();
+            ++seats.pushes[i];
+            ++pushed;
         }
     }
+    CLUB_STAT_ADD(PlayerWins, won);
+    CLUB_STAT_ADD(PlayerLosses, lost);
+    CLUB_STAT_ADD(PlayerPushes, pushed);
+    (void)won; (void)lost; (void)pushed;
 
-    // After all players settled, clear the dealer's hand for next round
+    seats.clearHands();
     dealer.clearHand();
 }
 
@@ -209,15 +454,20 @@ void Table::showDealerHand(bool revealAll) {
 /**
  * showPlayers()
  * --------------
- * Displays each player's name, cards, hand value, and bet.
+ * Displays each player's name, cards, hand value, and bet
+ * (one line per hand once a player has split).
  * Useful for debugging or when showing the current table state.
  */
 void Table::showPlayers() {
     for (auto* p : players) {
         if (!p) continue;
-        cout << "Player [" << p->getName() << "] hand=";
-        p->showHand();
-        cout << " value=" << p->handValue() << " | bet=$" << p->getBet() << endl;
+        for (int h = 0; h < p->handCount(); ++h) {
+            cout << "Player [" << p->getName() << "]";
+            if (p->handCount() > 1) cout << " hand " << (h + 1);
+            cout << " hand=";
+            p->showHand(h);
+            cout << " value=" << p->handAt(h).value() << " | bet=$" << p->betOn(h) << endl;
+        }
     }
 }
 
@@ -230,6 +480,15 @@ int Table::dealerHandValue() {
     return dealer.handValue();
 }
 
+/**
+ * dealerUpCard()
+ * ---------------
+ * Returns the value of the dealer's face-up card (-1 if none dealt).
+ */
+int Table::dealerUpCard() const {
+    return dealer.upCardValue();
+}
+
 /**
  * dealerBusted()
  * ---------------
@@ -239,6 +498,23 @@ bool Table::dealerBusted() {
     return dealer.handValue() > 21;
 }
 
+/**
+ * setRules(r) / refreshRules()
+ * ----------------------------
+ * Rules are only ever changed here, between rounds: the dealer's soft 17
+ * rule comes from the version the reader holds.
+ */
+void Table::setRules(RuleConfig::Reader* r) {
+    rules = r;
+    if (rules) dealer.setHitSoft17(rules->get().hitSoft17);
+}
+
+bool Table::refreshRules() {
+    if (!rules || !rules->refresh()) return false;
+    dealer.setHitSoft17(rules->get().hitSoft17);
+    return true;
+}
+
 /**
  * clearHands()
  * -------------
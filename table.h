@@ -7,9 +7,27 @@
 #include "player.h"
 #include "person.h"
 #include "dealer.h"
+#include "latency.h"
+#include "journal.h"
+#include "player_store.h"
+#include "spectator.h"
+#include "rules.h"
 
 using namespace std;
 
+/**
+ * RoundResult
+ * - One entry per round played by Table::playRounds().
+ */
+struct RoundResult {
+    int32_t net = 0;            // summed money delta of all seats
+    uint16_t wins = 0;
+    uint16_t losses = 0;
+    uint16_t pushes = 0;
+    uint8_t dealerTotal = 0;    // 0 if the dealer didn't need to play
+    uint8_t seatsPlayed = 0;
+};
+
 /**
 * Kenneth Nimmo
 * Knimmo1@dmacc.edu
@@ -22,8 +40,10 @@ using namespace std;
  * - Dealer follows house rules: hit on 16, stand on 17.
  *
  * Payouts:
- *  - Even money (+bet on win, -bet on loss).
+ *  - Even money (+bet on win, -bet on loss), settled per hand.
  *  - Push returns nothing (no money moved).
+ *  - Double: one card, bet doubled. Split: any pair, up to Player::kMaxHands
+ *    hands, doubling after a split allowed; split aces get one card each.
  *  - No blackjack/insurance/surrender here to keep it aligned with current APIs.
  */
 class Table {
@@ -37,9 +57,24 @@ public:
 
     // round flow helpers
     void startRound();  // clears all hands, deals 2 to everyone (players + dealer)
+    void playerHit(Player& p, int hand = 0);  // deals one card to a hand that chose to hit
+    void playerStand(Player& p);  // records a stand (no cards move)
+    bool playerDouble(Player& p, int hand = 0);  // false if the hand can't double
+    int playerSplit(Player& p, int hand = 0);    // new hand's index, -1 if it can't split
     void dealerPlay();  // dealer hits on 16, stands on 17+
     void settleBets();  // pays wins, collects losses, handles pushes
 
+    // fused automated rounds: n rounds, one pass over seats per phase,
+    // results written to out[0..n). Silent and not journaled.
+    // Defined in strategy.h (needs the policy dispatch helpers).
+    template <class Policy>
+    size_t playRounds(size_t n, Policy& policy, RoundResult* out);
+
+    // structure-of-arrays round flow (silent; for large simulated populations)
+    void startRound(PlayerStore& seats);
+    void playerHit(PlayerStore& seats, size_t seat) { seats.dealTo(seat, deck.deal()); }
+    void settleBets(PlayerStore& seats);
+
     // display helpers
     void showDealerUpCard();  // shows dealer's first card only
     void showDealerHand(bool revealAll = false);
@@ -47,11 +82,39 @@ public:
 
     // query helpers
     int dealerHandValue();
+    int dealerUpCard() const;           // -1 before the deal
+    const Deck& getDeck() const { return deck; }
+    const Dealer& getDealer() const { return dealer; }
+    const vector<Player*>& getPlayers() const { return players; }
     bool dealerBusted();
 
+    // house rules
+    void setHitSoft17(bool enable) { dealer.setHitSoft17(enable); }
+
+    // hot-reloadable house rules (nullptr = off; the reader must outlive
+    // the table). playRounds refreshes them before every round and holds
+    // seats to the bet limits; interactive drivers call refreshRules()
+    // between rounds. Returns true if a new version was picked up.
+    void setRules(RuleConfig::Reader* r);
+    bool refreshRules();
+    const TableRules* currentRules() const { return rules ? &rules->get() : nullptr; }
+
     // cleanup (e.g., after settleBets if you want to force-clear)
     void clearHands();
 
+    // hand history (nullptr = off); the journal must outlive the table
+    void setJournal(HandJournal* j) { journal = j; }
+
+    // quiet: settleBets prints nothing (load tests, many tables per process)
+    void setQuiet(bool q) { quiet = q; }
+
+    // spectator feed (nullptr = off): a frame after the deal, each player
+    // action, the dealer's play and settling. The feed must outlive the table.
+    void setSpectatorFeed(SpectatorFeed* f, uint32_t tableId = 1) { feed = f; feedTableId = tableId; }
+
+    // per-phase latency histograms (server-side work only, no prompts)
+    const RoundLatency& latencyStats() const { return latency; }
+
     // --- TEST HOOKS (use only in tests) ---
     void testClearDealer();  // clears dealer hand
     void testDealToDealer(int card); // deals a specific card to dealer (no deck)
@@ -60,10 +123,20 @@ private:
     Deck& deck;
     vector<Player*> players;
     Dealer dealer;  // Simple dealer; no bankroll tracked
+    RoundLatency latency;
+    HandJournal* journal = nullptr;
+    vector<uint8_t> drawn;   // dealer's draws this round, for the journal
+    bool quiet = false;
+    SpectatorFeed* feed = nullptr;
+    uint32_t feedTableId = 1;
+    uint32_t roundsStarted = 0;
+    RuleConfig::Reader* rules = nullptr;
 
     // internal helpers
     void dealOneToDealer();
-    void dealOneToPlayer(Player& p);
+    void dealOneToPlayer(Player& p, int hand = 0);
+    void snapshot(SpectatorFrame& f, uint8_t event) const;
+    void publish(uint8_t event) const;
 };
 
 #endif // TABLE_H
@@ -0,0 +1,252 @@
+/*
+ * Wallet Ledger Implementation
+ * ----------------------------
+ * The state word holds available money in the low 32 bits and reserved
+ * money in the high 32 bits. Each operation loads it, checks the rule
+ * (no overdraft on reserve), and CASes in the new pair; a failed CAS
+ * reloads and retries, so a table never waits on another one.
+ *
+ * Audit chunks and blocks are allocated by whichever writer first needs
+ * them; losers of the race to install one free theirs and use the
+ * winner's.
+ */
+
+#include "wallet.h"
+#include "deck.h"
+#include "numa.h"
+#include "player.h"
+#include "stats.h"
+#include "strategy.h"
+#include "table.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+using namespace std;
+
+namespace {
+
+// Returns slot's array, installing a zeroed one of n elements if it is
+// still empty.
+template <class T>
+T* installOnce(atomic<T*>& slot, size_t n) {
+    T* cur = slot.load(memory_order_acquire);
+    if (cur) return cur;
+    T* fresh = new T[n]();
+    if (slot.compare_exchange_strong(cur, fresh, memory_order_acq_rel, memory_order_acquire)) return fresh;
+    delete[] fresh;
+    return cur;
+}
+
+uint64_t pack(int64_t available, int64_t reserved) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(reserved)) << 32) | static_cast<uint32_t>(available);
+}
+
+int availableOf(uint64_t s) { return static_cast<int32_t>(static_cast<uint32_t>(s)); }
+int reservedOf(uint64_t s) { return static_cast<int32_t>(static_cast<uint32_t>(s >> 32)); }
+
+} // namespace
+
+Wallet::Wallet(int balance)
+    : state(pack(max(balance, 0), 0)), chunks(new atomic<Chunk*>[kMaxChunks]()) {
+    append(LedgerEntry::Open, 0, max(balance, 0), 0, state.load(memory_order_relaxed));
+}
+
+Wallet::~Wallet() {
+    for (size_t c = 0; c < kMaxChunks; ++c) {
+        Chunk* chunk = chunks[c].load(memory_order_relaxed);
+        if (!chunk) continue;
+        for (size_t b = 0; b < kChunkBlocks; ++b) delete[] chunk[b].load(memory_order_relaxed);
+        delete[] chunk;
+    }
+}
+
+int Wallet::available() const { return availableOf(state.load(memory_order_acquire)); }
+int Wallet::reserved() const { return reservedOf(state.load(memory_order_acquire)); }
+
+int Wallet::balance() const {
+    const uint64_t s = state.load(memory_order_acquire);
+    return availableOf(s) + reservedOf(s);
+}
+
+/**
+ * reserve(amount, table)
+ * ----------------------
+ * Moves `amount` from available to reserved in one CAS. If the available
+ * money is short the reservation is refused (and recorded as such).
+ */
+bool Wallet::reserve(int amount, uint32_t table) {
+    if (amount <= 0) return amount == 0;
+    uint64_t cur = state.load(memory_order_relaxed);
+    uint64_t next;
+    do {
+        if (availableOf(cur) < amount) {
+            append(LedgerEntry::Refused, table, amount, 0, cur);
+            return false;
+        }
+        next = pack(static_cast<int64_t>(availableOf(cur)) - amount, static_cast<int64_t>(reservedOf(cur)) + amount);
+    } while (!state.compare_exchange_weak(cur, next, memory_order_acq_rel, memory_order_relaxed));
+    append(LedgerEntry::Reserve, table, amount, 0, next);
+    return true;
+}
+
+void Wallet::release(int amount, uint32_t table) {
+    if (amount <= 0) return;
+    uint64_t cur = state.load(memory_order_relaxed);
+    uint64_t next;
+    do {
+        next = pack(static_cast<int64_t>(availableOf(cur)) + amount, static_cast<int64_t>(reservedOf(cur)) - amount);
+    } while (!state.compare_exchange_weak(cur, next, memory_order_acq_rel, memory_order_relaxed));
+    append(LedgerEntry::Release, table, amount, 0, next);
+}
+
+/**
+ * settle(stake, payout, table)
+ * ----------------------------
+ * Retires `stake` from reserved and credits `payout` to available, in the
+ * same CAS, so the money is never counted twice or not at all.
+ */
+void Wallet::settle(int stake, int payout, uint32_t table) {
+    if (stake < 0 || payout < 0) return;
+    uint64_t cur = state.load(memory_order_relaxed);
+    uint64_t next;
+    do {
+        next = pack(static_cast<int64_t>(availableOf(cur)) + payout, static_cast<int64_t>(reservedOf(cur)) - stake);
+    } while (!state.compare_exchange_weak(cur, next, memory_order_acq_rel, memory_order_relaxed));
+    append(LedgerEntry::Settle, table, stake, payout, next);
+}
+
+void Wallet::deposit(int amount, uint32_t table) {
+    if (amount <= 0) return;
+    uint64_t cur = state.load(memory_order_relaxed);
+    uint64_t next;
+    do {
+        next = pack(static_cast<int64_t>(availableOf(cur)) + amount, reservedOf(cur));
+    } while (!state.compare_exchange_weak(cur, next, memory_order_acq_rel, memory_order_relaxed));
+    append(LedgerEntry::Deposit, table, amount, 0, next);
+}
+
+void Wallet::append(LedgerEntry::Kind kind, uint32_t table, int amount, int payout, uint64_t after) {
+    const uint64_t seq = nextSeq.fetch_add(1, memory_order_relaxed);
+    const uint64_t b = seq / kBlockEntries;
+    if (b / kChunkBlocks >= kMaxChunks) {
+        if (dropped.fetch_add(1, memory_order_relaxed) == 0)
+            cerr << "wallet: audit trail full at " << seq << " entries; later operations are not recorded\n";
+        return;
+    }
+    Chunk* chunk = installOnce(chunks[static_cast<size_t>(b / kChunkBlocks)], kChunkBlocks);
+    Record* block = installOnce(chunk[static_cast<size_t>(b % kChunkBlocks)], kBlockEntries);
+    Record& r = block[seq % kBlockEntries];
+    r.entry.seq = seq;
+    r.entry.table = table;
+    r.entry.kind = kind;
+    r.entry.amount = amount;
+    r.entry.payout = payout;
+    r.entry.available = availableOf(after);
+    r.entry.reserved = reservedOf(after);
+    r.ready.store(true, memory_order_release);
+}
+
+vector<LedgerEntry> Wallet::audit() const {
+    vector<LedgerEntry> out;
+    const uint64_t n = min<uint64_t>(nextSeq.load(memory_order_acquire),
+        static_cast<uint64_t>(kBlockEntries) * kChunkBlocks * kMaxChunks);
+    out.reserve(static_cast<size_t>(n));
+    for (uint64_t seq = 0; seq < n; ++seq) {
+        const uint64_t b = seq / kBlockEntries;
+        const Chunk* chunk = chunks[static_cast<size_t>(b / kChunkBlocks)].load(memory_order_acquire);
+        if (!chunk) break;
+        const Record* block = chunk[static_cast<size_t>(b % kChunkBlocks)].load(memory_order_acquire);
+        if (!block) break;
+        const Record& r = block[seq % kBlockEntries];
+        if (!r.ready.load(memory_order_acquire)) break;
+        out.push_back(r.entry);
+    }
+    return out;
+}
+
+bool checkTrail(const vector<LedgerEntry>& trail, int available, int reserved) {
+    long long a = 0, r = 0;
+    for (const LedgerEntry& e : trail) {
+        switch (e.kind) {
+        case LedgerEntry::Open:
+        case LedgerEntry::Deposit: a += e.amount; break;
+        case LedgerEntry::Reserve: a -= e.amount; r += e.amount; break;
+        case LedgerEntry::Release: a += e.amount; r -= e.amount; break;
+        case LedgerEntry::Settle:  a += e.payout; r -= e.amount; break;
+        case LedgerEntry::Refused: break;
+        }
+    }
+    return a == available && r == reserved;
+}
+
+/**
+ * runWalletSim(tables, rounds, bankroll, bet)
+ * -------------------------------------------
+ * One seat per table, every seat on the same Wallet, each table playing
+ * basic strategy on its own pinned thread. A seat that finds the account
+ * fully reserved by the other tables waits (yields and retries) until
+ * they settle; one short of its bet plays what is available; every seat
+ * stops once the account is empty. At the end the wallet must equal the bankroll plus every
+ * table's net result, and the audit trail must replay to it.
+ */
+int runWalletSim(int tables, long long rounds, int bankroll, int bet) {
+    if (tables < 1 || rounds < 1 || bet < 1 || bankroll < bet) {
+        cout << "usage: sim-wallet [tables] [rounds per table] [bankroll >= bet] [bet]\n";
+        return 1;
+    }
+    Wallet wallet(bankroll);
+    vector<long long> played(static_cast<size_t>(tables), 0), net(static_cast<size_t>(tables), 0);
+    const uint64_t start = stats::nowNanos();
+    numa::runPinned(static_cast<size_t>(tables), [&](size_t t) {
+        const uint32_t id = static_cast<uint32_t>(t);
+        Deck deck(Deck::shoeSeed(7u, static_cast<int>(t)), 6);
+        Table table(deck);
+        Player seat("table " + to_string(t), bet);
+        seat.setBet(bet);                       // reserved round by round once attached
+        seat.attachWallet(&wallet, id);
+        table.addPlayer(&seat);
+        BasicStrategy policy;
+        RoundResult results[64];
+        long long done = 0, sum = 0;
+        while (done < rounds) {
+            const size_t n = table.playRounds(static_cast<size_t>(min<long long>(64, rounds - done)), policy, results);
+            for (size_t i = 0; i < n; ++i) sum += results[i].net;
+            done += static_cast<long long>(n);
+            if (n == 0) {
+                if (wallet.balance() <= 0) break;   // nothing left, reserved or not
+                this_thread::yield();           // the other tables hold it all; wait for a settle
+            }
+        }
+        seat.detachWallet();
+        played[t] = done;
+        net[t] = sum;
+    });
+    const double seconds = (stats::nowNanos() - start) / 1e9;
+
+    const vector<LedgerEntry> trail = wallet.audit();
+    long long totalRounds = 0, totalNet = 0, refused = 0;
+    for (int t = 0; t < tables; ++t) {
+        totalRounds += played[static_cast<size_t>(t)];
+        totalNet += net[static_cast<size_t>(t)];
+    }
+    for (const LedgerEntry& e : trail) refused += e.kind == LedgerEntry::Refused;
+    const bool balanced = wallet.reserved() == 0 && wallet.available() == bankroll + totalNet;
+    const bool replayed = wallet.auditDropped() == 0 && checkTrail(trail, wallet.available(), wallet.reserved());
+
+    cout << "=== one $" << bankroll << " wallet, " << tables << " tables, $" << bet << " bets ===\n";
+    cout << left << setw(8) << "Table" << right << setw(12) << "Rounds" << setw(12) << "Net($)" << "\n";
+    cout << string(32, '-') << "\n";
+    for (int t = 0; t < tables; ++t)
+        cout << left << setw(8) << t << right << setw(12) << played[static_cast<size_t>(t)]
+            << setw(12) << net[static_cast<size_t>(t)] << "\n";
+    cout << string(32, '-') << "\n";
+    cout << "wallet: $" << wallet.available() << " available, $" << wallet.reserved() << " reserved"
+        << " (expected $" << bankroll + totalNet << ")\n";
+    cout << "ledger: " << trail.size() << " entries, " << refused << " refused reservations, "
+        << fixed << setprecision(0) << trail.size() / max(seconds, 1e-9) << " ops/s\n";
+    cout << "balance " << (balanced ? "matches" : "DOES NOT match") << " the tables; trail "
+        << (replayed ? "replays" : "DOES NOT replay") << " to it\n";
+    return balanced && replayed ? 0 : 1;
+}
@@ -0,0 +1,101 @@
+#ifndef WALLET_H
+#define WALLET_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * LedgerEntry
+ * - One line of a Wallet's audit trail. `available` and `reserved` are the
+ *   balances right after this operation took effect.
+ * - Settle: `amount` is the reserved stake, `payout` what came back
+ *   (2x stake on a win, the stake on a push, 0 on a loss).
+ * - Refused: a reservation that would have overdrawn the account; it
+ *   moves no money.
+ */
+struct LedgerEntry {
+    enum Kind : uint8_t { Open = 0, Deposit, Reserve, Refused, Release, Settle };
+
+    uint64_t seq = 0;
+    uint32_t table = 0;             // caller's id for the table / seat
+    Kind kind = Open;
+    int32_t amount = 0;
+    int32_t payout = 0;
+    int32_t available = 0;
+    int32_t reserved = 0;
+};
+
+/**
+ * Wallet
+ * - One account shared by seats at several tables, each table on its own
+ *   thread. Available and reserved money are packed into one 64-bit word,
+ *   so every operation is a single compare-and-swap: no lock, no lost
+ *   update, and a reader always sees a consistent pair.
+ * - reserve() moves a stake from available to reserved, or refuses if the
+ *   account can't cover it; reserved money can only be settled or
+ *   released, so the account can never go below zero.
+ * - Every operation appends to an append-only audit trail: the entry's
+ *   slot is claimed with one fetch_add and published with a release
+ *   store, in lazily allocated blocks of kBlockEntries. Blocks are found
+ *   through directory chunks of kChunkBlocks, also allocated on first
+ *   use, so the trail grows with the account's traffic. Only past
+ *   kMaxChunks chunks (over four billion entries) does it stop: further
+ *   entries are counted in auditDropped() and the first one is reported
+ *   on stderr.
+ * - Sequence numbers are handed out after the balance changed, so two
+ *   racing entries may be numbered in the other order; each entry's
+ *   amounts are exact, so replaying the deltas (checkTrail) always ends on
+ *   the live balances.
+ */
+class Wallet {
+public:
+    static constexpr size_t kBlockEntries = 4096;
+    static constexpr size_t kChunkBlocks = 1024;
+    static constexpr size_t kMaxChunks = 1024;
+
+    explicit Wallet(int balance);
+    ~Wallet();
+    Wallet(const Wallet&) = delete;
+    Wallet& operator=(const Wallet&) = delete;
+
+    bool reserve(int amount, uint32_t table = 0);          // false if it would overdraw
+    void release(int amount, uint32_t table = 0);          // amount <= what the caller reserved
+    void settle(int stake, int payout, uint32_t table = 0);  // stake <= what the caller reserved
+    void deposit(int amount, uint32_t table = 0);
+
+    int available() const;
+    int reserved() const;
+    int balance() const;                // both halves from one load
+
+    // Published entries in sequence order (stops at the first one still
+    // being written).
+    std::vector<LedgerEntry> audit() const;
+    uint64_t auditCount() const { return nextSeq.load(std::memory_order_relaxed); }
+    uint64_t auditDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Record {
+        std::atomic<bool> ready{ false };
+        LedgerEntry entry;
+    };
+
+    std::atomic<uint64_t> state;        // reserved << 32 | available
+    std::atomic<uint64_t> nextSeq{ 0 };
+    std::atomic<uint64_t> dropped{ 0 };
+    using Chunk = std::atomic<Record*>;         // kChunkBlocks block pointers
+    std::unique_ptr<std::atomic<Chunk*>[]> chunks;
+
+    void append(LedgerEntry::Kind kind, uint32_t table, int amount, int payout, uint64_t after);
+};
+
+// True if replaying `trail` from zero ends on exactly these balances.
+bool checkTrail(const std::vector<LedgerEntry>& trail, int available, int reserved);
+
+// Driver mode "sim-wallet [tables] [rounds] [bankroll] [bet]": one account
+// playing `tables` tables at once; checks the ledger against the results.
+int runWalletSim(int tables, long long rounds, int bankroll, int bet);
+
+#endif // WALLET_H